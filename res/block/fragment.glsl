@@ -0,0 +1,28 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#version 130
+
+varying vec3 out_color;
+
+void 
+main(void)
+{
+	gl_FragColor = vec4(out_color, 1.f);
+}
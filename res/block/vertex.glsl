@@ -0,0 +1,47 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#version 130
+
+in uvec4 vertex;
+varying vec3 out_color;
+uniform mat4 mvp;
+
+// indexed by block type (low nibble) and face (high nibble)
+const vec3 BLOCK_COLOR[10] = vec3[10](
+	vec3(0.f, 0.f, 0.f),
+	vec3(0.1f, 0.1f, 0.1f),
+	vec3(0.2f, 0.4f, 0.8f),
+	vec3(0.86f, 0.8f, 0.56f),
+	vec3(0.47f, 0.33f, 0.2f),
+	vec3(0.33f, 0.6f, 0.2f),
+	vec3(0.33f, 0.6f, 0.2f),
+	vec3(0.5f, 0.5f, 0.5f),
+	vec3(0.92f, 0.94f, 0.96f),
+	vec3(0.92f, 0.94f, 0.96f)
+	);
+
+const float FACE_SHADE[6] = float[6](0.8f, 0.8f, 0.5f, 1.f, 0.65f, 0.65f);
+
+void 
+main(void)
+{
+	gl_Position = mvp * vec4(vec3(vertex.xyz), 1.f);
+	out_color = BLOCK_COLOR[vertex.w & 15u] * FACE_SHADE[vertex.w >> 4u];
+}
@@ -29,6 +29,8 @@
 #include "craft_define.h"
 #include "craft_exception.h"
 #include "craft_gl.h"
+#include "craft_image.h"
+#include "craft_simplex.h"
 #include "craft_random.h"
 
 using namespace CRAFT;
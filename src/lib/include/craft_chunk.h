@@ -39,6 +39,25 @@ namespace CRAFT {
 
 		#define CRAFT_BLOCK_MAX CRAFT_BLOCK_SNOW
 
+		typedef enum {
+			CRAFT_FACE_LEFT = 0,
+			CRAFT_FACE_RIGHT,
+			CRAFT_FACE_BOTTOM,
+			CRAFT_FACE_TOP,
+			CRAFT_FACE_BACK,
+			CRAFT_FACE_FRONT,
+		} craft_face;
+
+		#define CRAFT_FACE_MAX CRAFT_FACE_FRONT
+
+		typedef enum {
+			CRAFT_MESH_CULLED = 0,
+			CRAFT_MESH_GREEDY,
+			CRAFT_MESH_BINARY,
+		} craft_mesh_mode;
+
+		#define CRAFT_MESH_MAX CRAFT_MESH_BINARY
+
 		typedef struct {
 			uint8_t x;
 			uint8_t y;
@@ -46,6 +65,112 @@ namespace CRAFT {
 			uint8_t w;
 		} craft_uvec4;
 
+		typedef struct {
+			uint32_t faces;
+			uint32_t vertices;
+			double time;
+		} craft_mesh_stats;
+
+		typedef struct {
+			uint8_t temperature;
+			uint8_t moisture;
+		} craft_biome;
+
+		typedef class _craft_chunk_section {
+
+			public:
+
+				_craft_chunk_section(
+					__in_opt uint32_t length = 0,
+					__in_opt craft_block type = CRAFT_BLOCK_AIR
+					);
+
+				_craft_chunk_section(
+					__in const _craft_chunk_section &other
+					);
+
+				virtual ~_craft_chunk_section(void);
+
+				_craft_chunk_section &operator=(
+					__in const _craft_chunk_section &other
+					);
+
+				craft_block at(
+					__in uint32_t index
+					) const;
+
+				uint32_t bits(void) const;
+
+				void decode(
+					__out uint8_t *output,
+					__in uint32_t index,
+					__in uint32_t count,
+					__in_opt uint32_t stride = 1
+					) const;
+
+				bool is_uniform(
+					__in craft_block type
+					) const;
+
+				void mask(
+					__inout uint32_t *output,
+					__in uint32_t index,
+					__in uint32_t count,
+					__in const uint8_t *plane,
+					__in uint32_t planes
+					) const;
+
+				void pack(
+					__in const uint8_t *block,
+					__in uint32_t length
+					);
+
+				void pack(
+					__in const uint64_t *mask,
+					__in const uint64_t *present,
+					__in uint32_t columns,
+					__in uint32_t words,
+					__in uint32_t level
+					);
+
+				size_t resident(void) const;
+
+				void set(
+					__in uint32_t index,
+					__in craft_block type
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+			protected:
+
+				static uint32_t bits_for(
+					__in size_t count
+					);
+
+				static uint64_t spread(
+					__in uint64_t slice,
+					__in uint32_t bits
+					);
+
+				void widen(
+					__in uint32_t bits
+					);
+
+				uint32_t m_bits;
+
+				uint32_t m_length;
+
+				uint32_t m_occupied;
+
+				std::vector<uint8_t> m_palette;
+
+				std::vector<uint64_t> m_word;
+
+		} craft_chunk_section;
+
 		typedef class _craft_chunk {
 
 			public:
@@ -53,23 +178,33 @@ namespace CRAFT {
 				_craft_chunk(
 					__in const glm::vec2 &position,
 					__in const glm::vec3 &dimension,
-					__in const std::vector<uint8_t> &height
+					__in const std::vector<uint8_t> &height,
+					__in_opt const std::vector<craft_biome> &biome = std::vector<craft_biome>()
 					);
 
 				_craft_chunk(
-					__in const _craft_chunk &other
+					__inout _craft_chunk &&other
 					);
 
 				virtual ~_craft_chunk(void);
 
 				_craft_chunk &operator=(
-					__in const _craft_chunk &other
+					__inout _craft_chunk &&other
 					);
 
 				craft_block at(
 					__in const glm::vec3 &position
 					);
 
+				uint32_t border(void) const;
+
+				void clear_border(void);
+
+				void column(
+					__out uint8_t *output,
+					__in const glm::vec2 &position
+					) const;
+
 				glm::vec3 dimension(void);
 
 				bool has_changed(void);
@@ -82,56 +217,192 @@ namespace CRAFT {
 					__in const glm::vec3 &position
 					);
 
+				void layer(
+					__out uint8_t *output,
+					__in uint32_t level
+					) const;
+
+				const craft_mesh_stats &mesh(
+					__in_opt const std::vector<const _craft_chunk *> &neighbour = std::vector<const _craft_chunk *>()
+					);
+
+				craft_mesh_mode mesh_mode(void) const;
+
+				craft_mesh_stats mesh_stats(void) const;
+
+				static std::vector<uint32_t> neighbour_version(
+					__in const std::vector<const _craft_chunk *> &neighbour
+					);
+
 				glm::vec2 position(void);
 
-				void render(void);
+				const craft_mesh_stats &rebuild(
+					__in_opt const std::vector<const _craft_chunk *> &neighbour = std::vector<const _craft_chunk *>()
+					);
+
+				void render(
+					__in_opt GLuint attribute = 0
+					);
+
+				size_t resident(void) const;
+
+				glm::uvec2 section_range(void) const;
 
 				void set(
 					__in const glm::vec3 &position,
 					__in craft_block type
 					);
 
+				void set_changed(void);
+
+				void set_mesh_mode(
+					__in craft_mesh_mode mode
+					);
+
+				_craft_chunk snapshot(void) const;
+
 				static void to_file(
 					__in const std::string &path,
 					__in const _craft_chunk &chunk,
 					__in_opt bool vertical = false
 					);
 
+				static void to_map(
+					__out uint8_t *output,
+					__in size_t stride,
+					__in const _craft_chunk &chunk
+					);
+
 				virtual std::string to_string(
 					__in_opt bool verbose = false
 					);
 
-				void update(
-					__in GLfloat delta
+				bool upload(
+					__inout _craft_chunk &snapshot,
+					__in_opt const std::vector<const _craft_chunk *> &neighbour = std::vector<const _craft_chunk *>(),
+					__in_opt const std::vector<uint32_t> &version = std::vector<uint32_t>()
 					);
 
+				uint32_t version(void) const;
+
 			protected:
 
-				uint8_t &find_block(
-					__in const glm::vec3 &position
+				_craft_chunk(void);
+
+				_craft_chunk(
+					__in const _craft_chunk &other
+					);
+
+				_craft_chunk &operator=(
+					__in const _craft_chunk &other
+					);
+
+				void add_face(
+					__in uint32_t face,
+					__in uint8_t type,
+					__in const glm::uvec3 &origin,
+					__in const glm::uvec3 &extent
+					);
+
+				static void fill_column(
+					__out uint64_t *mask,
+					__in uint32_t words,
+					__in int32_t top,
+					__inout uint8_t &height,
+					__in const glm::ivec3 &level,
+					__in const float *cave,
+					__in uint64_t step,
+					__in const uint32_t *variation
 					);
 
+				craft_block find_block(
+					__in const glm::vec3 &position
+					) const;
+
 				std::vector<uint8_t>::iterator find_height(
 					__in const glm::vec2 &position
 					);
 
+				void gather_blocks(
+					__in const std::vector<const _craft_chunk *> &neighbour
+					);
+
+				void gather_masks(
+					__in const std::vector<const _craft_chunk *> &neighbour,
+					__in const glm::uvec2 &range
+					);
+
 				void generate_blocks(void);
 
+				void generate_caves(
+					__out std::vector<float> &cave,
+					__out std::vector<uint64_t> &step
+					);
+
+				void generate_levels(
+					__out std::vector<glm::ivec3> &level
+					);
+
 				void initialize(
 					__in const glm::vec2 &position,
 					__in const glm::vec3 &dimension,
-					__in const std::vector<uint8_t> &height
+					__in const std::vector<uint8_t> &height,
+					__in const std::vector<craft_biome> &biome
 					);
 
 				bool is_valid_height(
 					__in const glm::vec2 &position
-					);
+					) const;
 
 				bool is_valid_position(
 					__in const glm::vec3 &position
+					) const;
+
+				static void mask_clear(
+					__inout uint64_t *row,
+					__in uint32_t bit,
+					__in uint32_t count
+					);
+
+				void mask_column(
+					__out uint64_t *output,
+					__in uint32_t words,
+					__in const glm::uvec2 &position,
+					__in const glm::uvec2 &section
+					) const;
+
+				static uint32_t mask_run(
+					__in const uint64_t *row,
+					__in uint32_t bit,
+					__in uint32_t limit
+					);
+
+				void mesh_binary(
+					__in const glm::uvec2 &range
 					);
 
-				std::vector<std::vector<std::vector<uint8_t>>> m_block;
+				void mesh_culled(
+					__in const glm::uvec2 &range
+					);
+
+				void mesh_greedy(
+					__in const glm::uvec2 &range
+					);
+
+				void mesh_plane(
+					__in uint32_t face,
+					__in uint32_t slice,
+					__inout uint64_t *plane,
+					__in uint32_t rows,
+					__in uint32_t words,
+					__in const glm::uvec2 &axis
+					);
+
+				void upload_mesh(void);
+
+				std::vector<craft_biome> m_biome;
+
+				uint32_t m_border;
 
 				bool m_changed;
 
@@ -139,12 +410,100 @@ namespace CRAFT {
 
 				std::vector<uint8_t> m_height;
 
+				std::vector<craft_uvec4> m_mesh;
+
+				std::vector<uint8_t> m_mesh_block;
+
+				std::vector<uint64_t> m_mesh_column;
+
+				std::vector<uint8_t> m_mesh_mask;
+
+				craft_mesh_mode m_mesh_mode;
+
+				std::vector<uint64_t> m_mesh_plane;
+
+				craft_mesh_stats m_mesh_stats;
+
 				glm::vec2 m_position;
 
-				GLuint m_vertex_buffer;
+				std::vector<std::shared_ptr<craft_chunk_section>> m_section;
+
+				uint32_t m_version;
+
+				craft_gl_buffer m_vertex_buffer;
 
 				GLsizei m_vertex_buffer_length;
 		} craft_chunk;
+
+		typedef struct _craft_chunk_job {
+			glm::vec2 key;
+			std::unique_ptr<craft_chunk> chunk;
+			std::vector<std::unique_ptr<craft_chunk>> snapshot;
+			std::vector<const craft_chunk *> neighbour;
+			std::vector<uint32_t> version;
+			std::exception_ptr error;
+			struct _craft_chunk_job *next;
+		} craft_chunk_job;
+
+		typedef class _craft_chunk_pool {
+
+			public:
+
+				_craft_chunk_pool(void);
+
+				virtual ~_craft_chunk_pool(void);
+
+				size_t collect(
+					__out std::vector<std::unique_ptr<craft_chunk_job>> &output
+					);
+
+				void initialize(
+					__in_opt uint32_t threads = CHUNK_MESH_THREADS
+					);
+
+				bool is_initialized(void) const;
+
+				void submit(
+					__in const glm::vec2 &key,
+					__in const craft_chunk &chunk,
+					__in const std::vector<const craft_chunk *> &neighbour
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				_craft_chunk_pool(
+					__in const _craft_chunk_pool &other
+					);
+
+				_craft_chunk_pool &operator=(
+					__in const _craft_chunk_pool &other
+					);
+
+				void complete(
+					__in craft_chunk_job *job
+					);
+
+				void run(void);
+
+				std::atomic<craft_chunk_job *> m_complete;
+
+				std::condition_variable m_condition;
+
+				bool m_initialized;
+
+				std::deque<craft_chunk_job *> m_queue;
+
+				std::mutex m_queue_lock;
+
+				std::vector<std::thread> m_worker;
+
+		} craft_chunk_pool;
 	}
 }
 
@@ -30,23 +30,31 @@ namespace CRAFT {
 		#define CRAFT_CHUNK_EXCEPTION_HEADER EXCEPTION_HEADER
 #endif // NDEBUG
 		#define CRAFT_CHUNK_HEADER "<CHUNK>"
+		#define CRAFT_CHUNK_POOL_HEADER "<CHUNK_POOL>"
+		#define CRAFT_CHUNK_SECTION_HEADER "<CHUNK_SECTION>"
 
 		enum {
 			CRAFT_CHUNK_EXCEPTION_INVALID_DIMENSION = 0,
 			CRAFT_CHUNK_EXCEPTION_FILE_NOT_FOUND,
+			CRAFT_CHUNK_EXCEPTION_INVALID_BIOME_MAP,
 			CRAFT_CHUNK_EXCEPTION_INVALID_HEIGHT_MAP,
 			CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
 			CRAFT_CHUNK_EXCEPTION_INVALID_TYPE,
+			CRAFT_CHUNK_EXCEPTION_POOL_INITIALIZED,
+			CRAFT_CHUNK_EXCEPTION_POOL_UNINITIALIZED,
 		};
 
-		#define CRAFT_CHUNK_EXCEPTION_MAX CRAFT_CHUNK_EXCEPTION_INVALID_TYPE
+		#define CRAFT_CHUNK_EXCEPTION_MAX CRAFT_CHUNK_EXCEPTION_POOL_UNINITIALIZED
 
 		static const std::string CRAFT_CHUNK_EXCEPTION_STR[] = {
 			CRAFT_CHUNK_EXCEPTION_HEADER " Invalid dimension",
 			CRAFT_CHUNK_EXCEPTION_HEADER " File does not exist",
+			CRAFT_CHUNK_EXCEPTION_HEADER " Invalid biome map",
 			CRAFT_CHUNK_EXCEPTION_HEADER " Invalid height map",
 			CRAFT_CHUNK_EXCEPTION_HEADER " Invalid position",
 			CRAFT_CHUNK_EXCEPTION_HEADER " Invalid type",
+			CRAFT_CHUNK_EXCEPTION_HEADER " Mesh pool is initialized",
+			CRAFT_CHUNK_EXCEPTION_HEADER " Mesh pool is uninitialized",
 			};
 
 		#define CRAFT_CHUNK_EXCEPTION_STRING(_TYPE_) \
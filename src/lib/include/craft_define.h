@@ -20,14 +20,24 @@
 #ifndef CRAFT_DEFINE_H_
 #define CRAFT_DEFINE_H_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 #include <GL/glew.h>
@@ -57,6 +67,11 @@ namespace CRAFT {
 
 	#define BACKGROUND_COLOR glm::vec3{0.5, 0.5, 0.5} //glm::vec3{0.192156863, 0.301960784, 0.474509804}
 
+	#define BIOME_DESERT_MOISTURE 96
+	#define BIOME_DESERT_TEMPERATURE 160
+	#define BIOME_LEVEL_SPAN 16
+	#define BIOME_NEUTRAL 128
+
 	#define BLOCK_DIRT_LEVEL 96
 	#define BLOCK_GRASS_LEVEL 63
 	#define BLOCK_LAYER_VARIATION_MAX 13
@@ -75,7 +90,18 @@ namespace CRAFT {
 	#define CAMERA_UP {0.f, 1.f, 0.f}
 	#define CAMERA_YAW 0.f
 
+	#define CAVE_FLOOR 4
+	#define CAVE_FREQUENCY 0.04f
+	#define CAVE_OCTAVES 2
+	#define CAVE_PERSISTENCE 0.5f
+	#define CAVE_STEP_HEIGHT 8
+	#define CAVE_STEP_WIDTH 4
+	#define CAVE_THRESHOLD 0.45f
+
 	#define CHUNK_HEIGHT 128
+	#define CHUNK_MESH_BUDGET 2.0
+	#define CHUNK_MESH_THREADS 0
+	#define CHUNK_SECTION_HEIGHT 16
 	#define CHUNK_WIDTH 16
 
 	#define DISPLAY_ACCELERATE_VISUAL 1
@@ -92,6 +118,8 @@ namespace CRAFT {
 
 	#define GL_VERSION_VALID() ((DISPLAY_GL_VERSION) == GL_TRUE)
 
+	#define IMAGE_TILE_DIMENSION 256
+
 	#define KEY_AS_STRING(_KEY_) \
 		SDL_GetScancodeName(SDL_GetScancodeFromKey(_KEY_))
 
@@ -105,12 +133,15 @@ namespace CRAFT {
 	#define PERLIN_AMPLITUDE 1.0
 	#define PERLIN_DIMENSION 512
 	#define PERLIN_BICUBIC true
+	#define PERLIN_MODE CRAFT_PERLIN_TILED
 	#define PERLIN_POSITION glm::vec2{0.0, 0.0}
 	#define PERLIN_OCTAVES 8
 	#define PERLIN_PERSISTENCE 0.5
+	#define PERLIN_THREADS 0
 
 	#define PERLIN_SCALE_COLOR 255
 	#define PERLIN_SCALE_GREYSCALE 128
+	#define PERLIN_SCALE_WIDE 65535
 
 	#define REFERENCE_INITIAL 1
 
@@ -199,6 +199,48 @@ namespace CRAFT {
 			std::map<GLuint, std::pair<std::pair<std::pair<GLfloat, GLfloat>, GLint>, size_t>> m_texture_map;
 
 	} craft_gl;
+
+	typedef class _craft_gl_buffer {
+
+		public:
+
+			_craft_gl_buffer(void);
+
+			_craft_gl_buffer(
+				__inout _craft_gl_buffer &&other
+				);
+
+			virtual ~_craft_gl_buffer(void);
+
+			_craft_gl_buffer &operator=(
+				__inout _craft_gl_buffer &&other
+				);
+
+			void generate(void);
+
+			GLuint id(void) const;
+
+			bool is_generated(void) const;
+
+			void release(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+		protected:
+
+			_craft_gl_buffer(
+				__in const _craft_gl_buffer &other
+				);
+
+			_craft_gl_buffer &operator=(
+				__in const _craft_gl_buffer &other
+				);
+
+			GLuint m_id;
+
+	} craft_gl_buffer;
 }
 
 #endif // CRAFT_GL_H_
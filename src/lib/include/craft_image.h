@@ -0,0 +1,195 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRAFT_IMAGE_H_
+#define CRAFT_IMAGE_H_
+
+namespace CRAFT {
+
+	typedef enum {
+		CRAFT_IMAGE_GREYSCALE = 0,
+		CRAFT_IMAGE_COLOR,
+	} craft_image_format;
+
+	#define CRAFT_IMAGE_FORMAT_MAX CRAFT_IMAGE_COLOR
+
+	typedef class _craft_image_writer {
+
+		public:
+
+			_craft_image_writer(
+				__in const std::string &path,
+				__in const glm::uvec2 &dimension,
+				__in craft_image_format format,
+				__in_opt uint16_t maximum = UINT8_MAX,
+				__in_opt const std::string &comment = std::string()
+				);
+
+			virtual ~_craft_image_writer(void);
+
+			void close(void);
+
+			static std::string extension(
+				__in craft_image_format format
+				);
+
+			uint32_t row(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void write(
+				__in const uint8_t *row
+				);
+
+			void write(
+				__in const uint16_t *row
+				);
+
+		protected:
+
+			_craft_image_writer(
+				__in const _craft_image_writer &other
+				);
+
+			_craft_image_writer &operator=(
+				__in const _craft_image_writer &other
+				);
+
+			void flush(void);
+
+			uint8_t *reserve(
+				__in size_t length
+				);
+
+			std::vector<uint8_t> m_buffer;
+
+			size_t m_buffer_length;
+
+			uint32_t m_channels;
+
+			glm::uvec2 m_dimension;
+
+			std::ofstream m_file;
+
+			craft_image_format m_format;
+
+			uint16_t m_maximum;
+
+			std::string m_path;
+
+			uint32_t m_row;
+
+	} craft_image_writer;
+
+	typedef struct {
+		uint32_t levels;
+		uint32_t rendered;
+		uint32_t skipped;
+	} craft_tile_stats;
+
+	typedef class _craft_tile_renderer {
+
+		public:
+
+			_craft_tile_renderer(
+				__in_opt uint32_t tile = IMAGE_TILE_DIMENSION,
+				__in_opt uint32_t threads = PERLIN_THREADS
+				);
+
+			_craft_tile_renderer(
+				__in const _craft_tile_renderer &other
+				);
+
+			virtual ~_craft_tile_renderer(void);
+
+			_craft_tile_renderer &operator=(
+				__in const _craft_tile_renderer &other
+				);
+
+			void colorize(
+				__out std::vector<uint8_t> &color,
+				__in const std::vector<double> &noise,
+				__in const glm::uvec2 &dimension
+				);
+
+			static uint32_t level_count(
+				__in const glm::uvec2 &dimension,
+				__in uint32_t tile
+				);
+
+			craft_tile_stats render(
+				__in const std::string &path,
+				__in const std::vector<uint8_t> &color,
+				__in const glm::uvec2 &dimension
+				);
+
+			craft_tile_stats render(
+				__in const std::string &path,
+				__in const std::vector<double> &noise,
+				__in const glm::uvec2 &dimension
+				);
+
+			uint32_t tile(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+		protected:
+
+			static void downsample(
+				__out std::vector<uint8_t> &output,
+				__out glm::uvec2 &output_dimension,
+				__in const std::vector<uint8_t> &input,
+				__in const glm::uvec2 &input_dimension
+				);
+
+			static uint64_t hash_tile(
+				__in const std::vector<uint8_t> &tile
+				);
+
+			static bool is_current(
+				__in const std::string &path,
+				__in const std::string &comment,
+				__in size_t length
+				);
+
+			static void render_tiles(
+				__in const std::string &path,
+				__in const std::vector<uint8_t> &color,
+				__in const glm::uvec2 &dimension,
+				__in uint32_t tile,
+				__inout std::atomic<uint32_t> &next,
+				__inout std::atomic<uint32_t> &rendered,
+				__inout std::atomic<uint32_t> &skipped,
+				__out std::exception_ptr &error
+				);
+
+			std::vector<uint8_t> m_gradient;
+
+			uint32_t m_threads;
+
+			uint32_t m_tile;
+
+	} craft_tile_renderer;
+}
+
+#endif // CRAFT_IMAGE_H_
@@ -0,0 +1,68 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRAFT_IMAGE_TYPE_H_
+#define CRAFT_IMAGE_TYPE_H_
+
+namespace CRAFT {
+
+#ifndef NDEBUG
+	#define CRAFT_IMAGE_EXCEPTION_HEADER CRAFT_IMAGE_HEADER
+#else
+	#define CRAFT_IMAGE_EXCEPTION_HEADER EXCEPTION_HEADER
+#endif // NDEBUG
+	#define CRAFT_IMAGE_HEADER "<IMAGE>"
+	#define CRAFT_TILE_RENDERER_HEADER "<TILE_RENDERER>"
+
+	enum {
+		CRAFT_IMAGE_EXCEPTION_FILE_NOT_FOUND = 0,
+		CRAFT_IMAGE_EXCEPTION_FILE_WRITE,
+		CRAFT_IMAGE_EXCEPTION_INVALID_DEPTH,
+		CRAFT_IMAGE_EXCEPTION_INVALID_DIMENSION,
+		CRAFT_IMAGE_EXCEPTION_INVALID_FORMAT,
+		CRAFT_IMAGE_EXCEPTION_INVALID_LENGTH,
+		CRAFT_IMAGE_EXCEPTION_INVALID_ROW,
+		CRAFT_IMAGE_EXCEPTION_INVALID_TILE,
+	};
+
+	#define CRAFT_IMAGE_EXCEPTION_MAX CRAFT_IMAGE_EXCEPTION_INVALID_TILE
+
+	static const std::string CRAFT_IMAGE_EXCEPTION_STR[] = {
+		CRAFT_IMAGE_EXCEPTION_HEADER " File does not exist",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Failed to write file",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid sample depth",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid dimension",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid image format",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid length",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid row",
+		CRAFT_IMAGE_EXCEPTION_HEADER " Invalid tile dimension",
+		};
+
+	#define CRAFT_IMAGE_EXCEPTION_STRING(_TYPE_) \
+		((_TYPE_) > CRAFT_IMAGE_EXCEPTION_MAX ? EXCEPTION_UNKNOWN : \
+		STRING_CHECK(CRAFT_IMAGE_EXCEPTION_STR[_TYPE_]))
+
+	#define THROW_CRAFT_IMAGE_EXCEPTION(_EXCEPT_) \
+		THROW_EXCEPTION(CRAFT_IMAGE_EXCEPTION_STRING(_EXCEPT_))
+	#define THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+		THROW_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_STRING(_EXCEPT_), \
+		_FORMAT_, __VA_ARGS__)
+}
+
+#endif // CRAFT_IMAGE_TYPE_H_
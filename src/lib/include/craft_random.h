@@ -24,6 +24,121 @@
 
 namespace CRAFT {
 
+	typedef enum {
+		CRAFT_PERLIN_TILED = 0,
+		CRAFT_PERLIN_HASHED,
+	} craft_perlin_mode;
+
+	#define CRAFT_PERLIN_MODE_MAX CRAFT_PERLIN_HASHED
+
+	typedef enum {
+		CRAFT_PERLIN_LINEAR = 0,
+		CRAFT_PERLIN_COSINE,
+		CRAFT_PERLIN_HERMITE,
+		CRAFT_PERLIN_QUINTIC,
+	} craft_perlin_interpolation;
+
+	#define CRAFT_PERLIN_INTERPOLATION_MAX CRAFT_PERLIN_QUINTIC
+
+	typedef enum {
+		CRAFT_PERLIN_PLANAR = 0,
+		CRAFT_PERLIN_INTERLEAVED,
+	} craft_perlin_layout;
+
+	#define CRAFT_PERLIN_LAYOUT_MAX CRAFT_PERLIN_INTERLEAVED
+
+	typedef struct {
+		std::vector<uint32_t> column_cell;
+		std::vector<double> column_fade;
+		std::vector<double> lattice;
+		std::vector<double> line_bottom;
+		std::vector<double> line_top;
+		std::vector<double> strip;
+	} craft_perlin_band;
+
+	typedef struct {
+		std::vector<craft_perlin_band> band;
+		std::vector<double> rough;
+	} craft_perlin_workspace;
+
+	typedef struct {
+		glm::uvec2 dimension;
+		std::vector<double> noise;
+	} craft_perlin_level;
+
+	typedef void (*craft_perlin_task)(
+		__in void *context,
+		__in uint32_t index
+		);
+
+	typedef class _craft_perlin_pool {
+
+		public:
+
+			_craft_perlin_pool(void);
+
+			virtual ~_craft_perlin_pool(void);
+
+			void run(
+				__in craft_perlin_task task,
+				__in void *context,
+				__in uint32_t count
+				);
+
+			void start(
+				__in uint32_t threads
+				);
+
+			void stop(void);
+
+			uint32_t threads(void) const;
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+		protected:
+
+			_craft_perlin_pool(
+				__in const _craft_perlin_pool &other
+				);
+
+			_craft_perlin_pool &operator=(
+				__in const _craft_perlin_pool &other
+				);
+
+			void execute(void);
+
+			void work(void);
+
+			std::condition_variable m_condition;
+
+			std::condition_variable m_condition_done;
+
+			void *m_context;
+
+			uint32_t m_count;
+
+			std::exception_ptr m_error;
+
+			uint64_t m_generation;
+
+			std::mutex m_lock;
+
+			uint32_t m_next;
+
+			uint32_t m_remaining;
+
+			std::mutex m_run_lock;
+
+			bool m_running;
+
+			craft_perlin_task m_task;
+
+			std::vector<std::thread> m_worker;
+
+	} craft_perlin_pool;
+
 	typedef class _craft_perlin_2d {
 
 		public:
@@ -39,7 +154,147 @@ namespace CRAFT {
 				__in uint32_t octaves,
 				__in double amplitude,
 				__in double persistence,
-				__in_opt bool bicubic = true
+				__in_opt bool bicubic = true,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			std::vector<double> generate(
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in craft_perlin_interpolation interpolation,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out double *output,
+				__in size_t length,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out float *output,
+				__in size_t length,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out uint8_t *output,
+				__in size_t length,
+				__in double scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out uint16_t *output,
+				__in size_t length,
+				__in double scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out float *output,
+				__in size_t length,
+				__in const std::vector<double> &scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_layout layout = CRAFT_PERLIN_PLANAR,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate(
+				__out uint8_t *output,
+				__in size_t length,
+				__in const std::vector<double> &scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_layout layout = CRAFT_PERLIN_PLANAR,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			std::vector<double> generate_level(
+				__out glm::uvec2 &dimension,
+				__in uint32_t level,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			std::vector<craft_perlin_level> generate_pyramid(
+				__in uint32_t levels,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			static void gradient_color(
+				__in double value,
+				__out uint8_t *color
 				);
 
 			void initialize(void);
@@ -48,11 +303,24 @@ namespace CRAFT {
 
 			bool is_initialized(void);
 
+			static uint32_t level_count(
+				__in const glm::uvec2 &dimension
+				);
+
 			static void to_file(
 				__in const std::string &path,
 				__in const std::vector<double> &noise,
 				__in const glm::uvec2 &dimension,
-				__in_opt bool colorize = false
+				__in_opt bool colorize = false,
+				__in_opt bool wide = false
+				);
+
+			static void to_file(
+				__in const std::string &path,
+				__in const std::vector<craft_perlin_level> &pyramid,
+				__in uint32_t level,
+				__in_opt bool colorize = false,
+				__in_opt bool wide = false
 				);
 
 			std::string to_string(
@@ -75,25 +343,213 @@ namespace CRAFT {
 
 			static void _delete(void);
 
-			void generate_noise(
-				__out std::vector<std::vector<double>> &noise,
+			template <class P> static double accumulate_band(
+				__out double *result,
+				__inout craft_perlin_band &band,
 				__in const glm::uvec2 &dimension,
-				__in const glm::vec2 &position,
+				__in uint32_t level,
+				__in const glm::ivec2 &base,
+				__in uint32_t row_begin,
+				__in uint32_t row_end,
 				__in uint32_t octaves,
-				__in_opt bool bicubic = true
+				__in double amplitude,
+				__in double persistence,
+				__in craft_perlin_mode mode,
+				__in uint32_t seed,
+				__in const double *rough
 				);
 
-			double interpolate_noise(
-				__in const glm::vec3 &value,
-				__in_opt bool bicubic = true
+			template <class P> static void accumulate_noise(
+				__inout double *result,
+				__in const double *top,
+				__in const double *bottom,
+				__in double weight,
+				__in double amplitude,
+				__in uint32_t count
+				);
+
+			template <class P> static void blend_noise(
+				__out std::vector<double> &line,
+				__in const double *lattice,
+				__in const uint32_t *cell,
+				__in const double *fade
+				);
+
+			template <typename T, class P> static void generate_band(
+				__out T *output,
+				__inout craft_perlin_band &band,
+				__in const double *scale,
+				__in uint32_t channels,
+				__in craft_perlin_layout layout,
+				__in const glm::uvec2 &dimension,
+				__in uint32_t level,
+				__in const glm::ivec2 &base,
+				__in uint32_t row_begin,
+				__in uint32_t row_end,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in craft_perlin_mode mode,
+				__in uint32_t seed,
+				__in const double *rough
+				);
+
+			template <typename T> void generate_noise(
+				__out T *output,
+				__inout craft_perlin_workspace &workspace,
+				__in const double *scale,
+				__in uint32_t channels,
+				__in craft_perlin_layout layout,
+				__in const glm::uvec2 &dimension,
+				__in const glm::ivec2 &origin,
+				__in uint32_t level,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1,
+				__in_opt bool redraw = true
+				);
+
+			void generate_region(
+				__out glm::uvec2 &dimension,
+				__out glm::ivec2 &origin,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED
+				);
+
+			template <typename T> static void generate_task(
+				__in void *context,
+				__in uint32_t index
+				);
+
+			static double hash_noise(
+				__in uint32_t seed,
+				__in int32_t x,
+				__in int32_t y
+				);
+
+			template <typename T> static void store_noise(
+				__out T *output,
+				__in const double *result,
+				__in uint32_t count,
+				__in double total,
+				__in double scale,
+				__in_opt uint32_t stride = 1
 				);
 
 			bool m_initialized;
 
 			static _craft_perlin_2d *m_instance;
 
+			craft_perlin_pool m_pool;
+
 	} craft_perlin_2d;
 
+	typedef class _craft_random_stream {
+
+		public:
+
+			_craft_random_stream(
+				__in_opt uint32_t seed = 0,
+				__in_opt uint32_t id = 0,
+				__in_opt uint64_t counter = 0
+				);
+
+			_craft_random_stream(
+				__in const _craft_random_stream &other
+				);
+
+			virtual ~_craft_random_stream(void);
+
+			_craft_random_stream &operator=(
+				__in const _craft_random_stream &other
+				);
+
+			uint64_t counter(void);
+
+			double generate_float(
+				__in_opt double min = 0.0,
+				__in_opt double max = 1.0
+				);
+
+			void generate_float(
+				__out double *output,
+				__in size_t count,
+				__in_opt double min = 0.0,
+				__in_opt double max = 1.0
+				);
+
+			int32_t generate_signed(
+				__in_opt int32_t min = INT32_MIN,
+				__in_opt int32_t max = INT32_MAX
+				);
+
+			void generate_signed(
+				__out int32_t *output,
+				__in size_t count,
+				__in_opt int32_t min = INT32_MIN,
+				__in_opt int32_t max = INT32_MAX
+				);
+
+			uint32_t generate_unsigned(
+				__in_opt uint32_t min = 0,
+				__in_opt uint32_t max = UINT32_MAX
+				);
+
+			void generate_unsigned(
+				__out uint32_t *output,
+				__in size_t count,
+				__in_opt uint32_t min = 0,
+				__in_opt uint32_t max = UINT32_MAX
+				);
+
+			uint32_t id(void);
+
+			uint32_t seed(void);
+
+			void seek(
+				__in uint64_t counter
+				);
+
+			virtual std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+		protected:
+
+			uint32_t generate_bounded(
+				__in uint64_t range
+				);
+
+			void generate_bounded(
+				__out uint32_t *output,
+				__in size_t count,
+				__in uint64_t range
+				);
+
+			void generate_block(void);
+
+			uint32_t generate_word(void);
+
+			void generate_words(
+				__out uint32_t *output,
+				__in size_t count
+				);
+
+			uint32_t m_block[4];
+
+			uint64_t m_counter;
+
+			uint32_t m_id;
+
+			uint32_t m_seed;
+
+	} craft_random_stream;
+
 	typedef class _craft_random {
 
 		public:
@@ -102,11 +558,35 @@ namespace CRAFT {
 
 			static _craft_random *acquire(void);
 
+			static uint32_t derive_seed(
+				__in uint32_t seed,
+				__in uint32_t index
+				);
+
 			double generate_float(
 				__in_opt double min = 0.0,
 				__in_opt double max = 1.0
 				);
 
+			void generate_float(
+				__out double *output,
+				__in size_t count,
+				__in_opt double min = 0.0,
+				__in_opt double max = 1.0
+				);
+
+			std::vector<double> generate_perlin_2d(
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt bool bicubic = true,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
 			std::vector<double> generate_perlin_2d(
 				__out glm::uvec2 &dimension,
 				__in const glm::vec2 &position,
@@ -114,7 +594,130 @@ namespace CRAFT {
 				__in uint32_t octaves,
 				__in double amplitude,
 				__in double persistence,
-				__in_opt bool bicubic = true
+				__in craft_perlin_interpolation interpolation,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out double *output,
+				__in size_t length,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out float *output,
+				__in size_t length,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out uint8_t *output,
+				__in size_t length,
+				__in double scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out uint16_t *output,
+				__in size_t length,
+				__in double scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out float *output,
+				__in size_t length,
+				__in const std::vector<double> &scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_layout layout = CRAFT_PERLIN_PLANAR,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			void generate_perlin_2d(
+				__out uint8_t *output,
+				__in size_t length,
+				__in const std::vector<double> &scale,
+				__inout craft_perlin_workspace &workspace,
+				__out glm::uvec2 &dimension,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_layout layout = CRAFT_PERLIN_PLANAR,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			std::vector<double> generate_perlin_2d_level(
+				__out glm::uvec2 &dimension,
+				__in uint32_t level,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
+				);
+
+			std::vector<craft_perlin_level> generate_perlin_2d_pyramid(
+				__in uint32_t levels,
+				__in const glm::vec2 &position,
+				__in const glm::vec2 &offset,
+				__in uint32_t octaves,
+				__in double amplitude,
+				__in double persistence,
+				__in_opt craft_perlin_interpolation interpolation = CRAFT_PERLIN_COSINE,
+				__in_opt craft_perlin_mode mode = CRAFT_PERLIN_TILED,
+				__in_opt uint32_t threads = 1
 				);
 
 			int32_t generate_signed(
@@ -122,11 +725,25 @@ namespace CRAFT {
 				__in_opt int32_t max = INT32_MAX
 				);
 
+			void generate_signed(
+				__out int32_t *output,
+				__in size_t count,
+				__in_opt int32_t min = INT32_MIN,
+				__in_opt int32_t max = INT32_MAX
+				);
+
 			uint32_t generate_unsigned(
 				__in_opt uint32_t min = 0,
 				__in_opt uint32_t max = UINT32_MAX
 				);
 
+			void generate_unsigned(
+				__out uint32_t *output,
+				__in size_t count,
+				__in_opt uint32_t min = 0,
+				__in_opt uint32_t max = UINT32_MAX
+				);
+
 			void initialize(
 				__in uint32_t seed
 				);
@@ -139,6 +756,10 @@ namespace CRAFT {
 
 			uint32_t seed(void);
 
+			craft_random_stream stream(
+				__in uint32_t id
+				);
+
 			std::string to_string(
 				__in_opt bool verbose = false
 				);
@@ -159,12 +780,20 @@ namespace CRAFT {
 
 			static void _delete(void);
 
+			uint32_t generate_bounded(
+				__in uint64_t range
+				);
+
 			std::mt19937 m_engine;
 
 			bool m_initialized;
 
 			craft_perlin_2d *m_instance_perlin_2d;
 
+			craft_simplex_2d *m_instance_simplex_2d;
+
+			craft_simplex_3d *m_instance_simplex_3d;
+
 			static _craft_random *m_instance;
 
 			uint32_t m_seed;
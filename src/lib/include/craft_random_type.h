@@ -28,12 +28,20 @@ namespace CRAFT {
 	#define CRAFT_RANDOM_EXCEPTION_HEADER EXCEPTION_HEADER
 #endif // NDEBUG
 	#define CRAFT_PERLIN_2D_HEADER "<PERLIN2D>"
+	#define CRAFT_PERLIN_POOL_HEADER "<PERLIN_POOL>"
 	#define CRAFT_RANDOM_HEADER "<RANDOM>"
+	#define CRAFT_RANDOM_STREAM_HEADER "<RANDOM_STREAM>"
 
 	enum {
 		CRAFT_RANDOM_EXCEPTION_ALLOCATED = 0,
 		CRAFT_RANDOM_EXCEPTION_FILE_NOT_FOUND,
 		CRAFT_RANDOM_EXCEPTION_INITIALIZED,
+		CRAFT_RANDOM_EXCEPTION_INVALID_CHANNELS,
+		CRAFT_RANDOM_EXCEPTION_INVALID_INTERPOLATION,
+		CRAFT_RANDOM_EXCEPTION_INVALID_LAYOUT,
+		CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+		CRAFT_RANDOM_EXCEPTION_INVALID_LEVEL,
+		CRAFT_RANDOM_EXCEPTION_INVALID_MODE,
 		CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
 		CRAFT_RANDOM_EXCEPTION_UNINITIALIZED,
 	};
@@ -44,6 +52,12 @@ namespace CRAFT {
 		CRAFT_RANDOM_EXCEPTION_HEADER " Failed to allocate random component",
 		CRAFT_RANDOM_EXCEPTION_HEADER " File does not exist",
 		CRAFT_RANDOM_EXCEPTION_HEADER " Random component is initialized",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid channel count",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid noise interpolation",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid noise layout",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid buffer length",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid pyramid level",
+		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid noise mode",
 		CRAFT_RANDOM_EXCEPTION_HEADER " Invalid range",
 		CRAFT_RANDOM_EXCEPTION_HEADER " Random component is uninitialized",
 		};
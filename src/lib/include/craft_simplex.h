@@ -0,0 +1,177 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRAFT_SIMPLEX_H_
+#define CRAFT_SIMPLEX_H_
+
+namespace CRAFT {
+
+	typedef class _craft_simplex_2d {
+
+		public:
+
+			~_craft_simplex_2d(void);
+
+			static _craft_simplex_2d *acquire(void);
+
+			void generate(
+				__out float *output,
+				__in const float *x,
+				__in const float *y,
+				__in size_t count,
+				__in_opt uint32_t octaves = 1,
+				__in_opt float frequency = 1.f,
+				__in_opt float persistence = 0.5f
+				);
+
+			void generate(
+				__out std::vector<float> &output,
+				__in const std::vector<glm::vec2> &point,
+				__in_opt uint32_t octaves = 1,
+				__in_opt float frequency = 1.f,
+				__in_opt float persistence = 0.5f
+				);
+
+			void initialize(void);
+
+			static bool is_allocated(void);
+
+			bool is_initialized(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+		protected:
+
+			_craft_simplex_2d(void);
+
+			_craft_simplex_2d(
+				__in const _craft_simplex_2d &other
+				);
+
+			_craft_simplex_2d &operator=(
+				__in const _craft_simplex_2d &other
+				);
+
+			static void _delete(void);
+
+			static void accumulate_noise(
+				__inout float *output,
+				__in const float *x,
+				__in const float *y,
+				__in size_t count,
+				__in uint32_t seed,
+				__in float frequency,
+				__in float amplitude
+				);
+
+			static float evaluate_noise(
+				__in float x,
+				__in float y,
+				__in uint32_t seed
+				);
+
+			bool m_initialized;
+
+			static _craft_simplex_2d *m_instance;
+
+	} craft_simplex_2d;
+
+	typedef class _craft_simplex_3d {
+
+		public:
+
+			~_craft_simplex_3d(void);
+
+			static _craft_simplex_3d *acquire(void);
+
+			void generate(
+				__out float *output,
+				__in const float *x,
+				__in const float *y,
+				__in const float *z,
+				__in size_t count,
+				__in_opt uint32_t octaves = 1,
+				__in_opt float frequency = 1.f,
+				__in_opt float persistence = 0.5f
+				);
+
+			void generate(
+				__out std::vector<float> &output,
+				__in const std::vector<glm::vec3> &point,
+				__in_opt uint32_t octaves = 1,
+				__in_opt float frequency = 1.f,
+				__in_opt float persistence = 0.5f
+				);
+
+			void initialize(void);
+
+			static bool is_allocated(void);
+
+			bool is_initialized(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+		protected:
+
+			_craft_simplex_3d(void);
+
+			_craft_simplex_3d(
+				__in const _craft_simplex_3d &other
+				);
+
+			_craft_simplex_3d &operator=(
+				__in const _craft_simplex_3d &other
+				);
+
+			static void _delete(void);
+
+			static void accumulate_noise(
+				__inout float *output,
+				__in const float *x,
+				__in const float *y,
+				__in const float *z,
+				__in size_t count,
+				__in uint32_t seed,
+				__in float frequency,
+				__in float amplitude
+				);
+
+			static float evaluate_noise(
+				__in float x,
+				__in float y,
+				__in float z,
+				__in uint32_t seed
+				);
+
+			bool m_initialized;
+
+			static _craft_simplex_3d *m_instance;
+
+	} craft_simplex_3d;
+}
+
+#endif // CRAFT_SIMPLEX_H_
@@ -0,0 +1,61 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRAFT_SIMPLEX_TYPE_H_
+#define CRAFT_SIMPLEX_TYPE_H_
+
+namespace CRAFT {
+
+#ifndef NDEBUG
+	#define CRAFT_SIMPLEX_EXCEPTION_HEADER CRAFT_SIMPLEX_HEADER
+#else
+	#define CRAFT_SIMPLEX_EXCEPTION_HEADER EXCEPTION_HEADER
+#endif // NDEBUG
+	#define CRAFT_SIMPLEX_2D_HEADER "<SIMPLEX2D>"
+	#define CRAFT_SIMPLEX_3D_HEADER "<SIMPLEX3D>"
+	#define CRAFT_SIMPLEX_HEADER "<SIMPLEX>"
+
+	enum {
+		CRAFT_SIMPLEX_EXCEPTION_ALLOCATED = 0,
+		CRAFT_SIMPLEX_EXCEPTION_INITIALIZED,
+		CRAFT_SIMPLEX_EXCEPTION_INVALID_PARAMETER,
+		CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED,
+	};
+
+	#define CRAFT_SIMPLEX_EXCEPTION_MAX CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED
+
+	static const std::string CRAFT_SIMPLEX_EXCEPTION_STR[] = {
+		CRAFT_SIMPLEX_EXCEPTION_HEADER " Failed to allocate simplex component",
+		CRAFT_SIMPLEX_EXCEPTION_HEADER " Simplex component is initialized",
+		CRAFT_SIMPLEX_EXCEPTION_HEADER " Invalid parameter",
+		CRAFT_SIMPLEX_EXCEPTION_HEADER " Simplex component is uninitialized",
+		};
+
+	#define CRAFT_SIMPLEX_EXCEPTION_STRING(_TYPE_) \
+		((_TYPE_) > CRAFT_SIMPLEX_EXCEPTION_MAX ? EXCEPTION_UNKNOWN : \
+		STRING_CHECK(CRAFT_SIMPLEX_EXCEPTION_STR[_TYPE_]))
+
+	#define THROW_CRAFT_SIMPLEX_EXCEPTION(_EXCEPT_) \
+		THROW_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_STRING(_EXCEPT_))
+	#define THROW_CRAFT_SIMPLEX_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+		THROW_EXCEPTION_FORMAT(CRAFT_SIMPLEX_EXCEPTION_STRING(_EXCEPT_), \
+		_FORMAT_, __VA_ARGS__)
+}
+
+#endif // CRAFT_SIMPLEX_TYPE_H_
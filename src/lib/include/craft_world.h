@@ -38,6 +38,16 @@ namespace CRAFT {
 					) const;
 		} craft_position_key;
 
+		typedef struct {
+			uint32_t chunks;
+			uint32_t faces;
+			uint64_t vertices;
+			uint64_t bytes;
+			double time;
+			double time_max;
+			uint32_t over_budget;
+		} craft_mesh_report;
+
 		typedef class _craft_world {
 
 			public:
@@ -79,10 +89,24 @@ namespace CRAFT {
 
 				void poll_input(void);
 
+				craft_mesh_report remesh(
+					__in craft_mesh_mode mode
+					);
+
 				void render(void);
 
 				void reset(void);
 
+				glm::uvec2 section_range(
+					__in const glm::vec2 &position
+					);
+
+				craft_tile_stats to_map(
+					__in const std::string &path,
+					__in_opt uint32_t tile = IMAGE_TILE_DIMENSION,
+					__in_opt uint32_t threads = PERLIN_THREADS
+					);
+
 				std::string to_string(
 					__in_opt bool verbose = false
 					);
@@ -115,6 +139,15 @@ namespace CRAFT {
 
 				static void _delete(void);
 
+				const craft_chunk *find_chunk(
+					__in const glm::vec2 &position
+					) const;
+
+				void find_neighbour(
+					__in const glm::vec2 &position,
+					__out std::vector<const craft_chunk *> &neighbour
+					) const;
+
 				void setup(
 					__in uint32_t seed,
 					__in double dimension,
@@ -126,12 +159,25 @@ namespace CRAFT {
 
 				void teardown(void);
 
+				GLint m_block_attribute;
+
+				GLint m_block_matrix;
+
+				GLuint m_block_program;
+
+				GLuint m_block_shader_fragment;
+
+				GLuint m_block_shader_vertex;
+
 				std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
 					craft_position_key> m_chunk_map;
 
-				craft_font m_font;
+				std::unordered_map<glm::vec2, std::pair<uint32_t, std::vector<uint32_t>>, craft_position_key, 
+					craft_position_key> m_chunk_pending;
 
-				std::vector<double> m_height_list;
+				craft_chunk_pool m_chunk_pool;
+
+				craft_font m_font;
 
 				bool m_initialized;
 
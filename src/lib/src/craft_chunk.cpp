@@ -17,7 +17,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include <fstream>
+#if defined(__AVX__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif // __AVX__ || __BMI2__
 #include "../include/craft.h"
 #include "../include/craft_chunk_type.h"
 
@@ -42,394 +46,2228 @@ namespace CRAFT {
 			((_TYPE_) > CRAFT_BLOCK_MAX ? CRAFT_BLOCK_COL[CRAFT_BLOCK_AIR] : \
 			CRAFT_BLOCK_COL[_TYPE_])
 
+		#define CHUNK_BIOME_OFFSET(_VALUE_) \
+			((((int32_t) (_VALUE_) - BIOME_NEUTRAL) * BIOME_LEVEL_SPAN) / BIOME_NEUTRAL)
+
+		#define CHUNK_CAVE_BLEND(_FIRST_, _SECOND_, _FRACTION_) \
+			((_FIRST_) + (((_SECOND_) - (_FIRST_)) * (_FRACTION_)))
+		#define CHUNK_CAVE_INDEX(_X_, _Y_, _Z_, _COUNT_) \
+			((((_Z_) * (_COUNT_).y) + (_Y_)) * (_COUNT_).x + (_X_))
+		#define CHUNK_CAVE_LEVELS(_HEIGHT_) \
+			((((uint32_t) (_HEIGHT_) + CAVE_STEP_HEIGHT - 1) / CAVE_STEP_HEIGHT) + 1)
+		#define CHUNK_CAVE_MARGIN 1e-4f
+		#define CHUNK_CAVE_OPEN(_CAVE_, _Y_) \
+			(CHUNK_CAVE_BLEND((_CAVE_)[(_Y_) / CAVE_STEP_HEIGHT], (_CAVE_)[((_Y_) / CAVE_STEP_HEIGHT) + 1], \
+			((_Y_) % CAVE_STEP_HEIGHT) / (float) CAVE_STEP_HEIGHT) > CAVE_THRESHOLD)
+
+		#define CHUNK_FACE_CORNERS 4
+		#define CHUNK_FACE_VERTICES 6
+		#define CHUNK_FACE_VISIBLE(_TYPE_, _NEIGHBOUR_) \
+			(((_NEIGHBOUR_) == CRAFT_BLOCK_AIR) || (((_NEIGHBOUR_) == CRAFT_BLOCK_WATER) \
+			&& ((_TYPE_) != CRAFT_BLOCK_WATER)))
+
+		#define CHUNK_LAYER_VARIATION_SPAN (BLOCK_LAYER_VARIATION_MAX - BLOCK_LAYER_VARIATION_MIN)
+
+		#define CHUNK_MASK_COLUMN(_COLUMN_, _WORDS_) ((size_t) (_COLUMN_) * CHUNK_MASK_PLANES * (_WORDS_))
+		#define CHUNK_MASK_CTZ(_WORD_) ((uint32_t) __builtin_ctzll(_WORD_))
+		#define CHUNK_MASK_VISIBLE(_SOLID_, _WATER_, _NEIGHBOUR_SOLID_, _NEIGHBOUR_WATER_) \
+			(((_SOLID_) & ~(_NEIGHBOUR_SOLID_)) | ((_WATER_) & ~((_NEIGHBOUR_SOLID_) | (_NEIGHBOUR_WATER_))))
+		#define CHUNK_MASK_PLANES 2
+		#define CHUNK_MASK_WORDS(_BITS_) \
+			(((uint32_t) (_BITS_) + SECTION_WORD_BITS - 1) / SECTION_WORD_BITS)
+
+		#define CHUNK_MESH_INDEX(_X_, _Y_, _Z_, _DIMENSION_) \
+			(((((size_t) ((int32_t) (_Z_) + 1) * ((size_t) (_DIMENSION_).x + 2)) + (size_t) ((int32_t) (_X_) + 1)) \
+			* ((size_t) (_DIMENSION_).y + 2)) + (size_t) ((int32_t) (_Y_) + 1))
+		#define CHUNK_MESH_OFFSET(_FACE_, _DIMENSION_) \
+			((int64_t) CHUNK_FACE_NORMAL[_FACE_][1] + ((int64_t) CHUNK_FACE_NORMAL[_FACE_][0] \
+			* ((int64_t) (_DIMENSION_).y + 2)) + ((int64_t) CHUNK_FACE_NORMAL[_FACE_][2] \
+			* ((int64_t) (_DIMENSION_).x + 2) * ((int64_t) (_DIMENSION_).y + 2)))
+		#define CHUNK_MESH_LENGTH(_DIMENSION_) \
+			(((size_t) (_DIMENSION_).x + 2) * ((size_t) (_DIMENSION_).y + 2) * ((size_t) (_DIMENSION_).z + 2))
+		#define CHUNK_MESH_VERTEX(_FACE_, _TYPE_) ((uint8_t) (((_FACE_) << 4) | (_TYPE_)))
+
+		#define CHUNK_RUN_FILL(_MASK_, _BEGIN_, _END_) { \
+			int32_t _begin_ = (_BEGIN_), _end_ = (_END_), _last_; \
+			for(; _begin_ <= _end_; _begin_ = (_last_ + 1)) { \
+				_last_ = std::min(_end_, (int32_t) (_begin_ | (SECTION_WORD_BITS - 1))); \
+				(_MASK_)[_begin_ / SECTION_WORD_BITS] |= ((~0ULL >> ((SECTION_WORD_BITS - 1) \
+					- (_last_ % SECTION_WORD_BITS))) & (~0ULL << (_begin_ % SECTION_WORD_BITS))); \
+			} \
+			}
+		#define CHUNK_RUN_MASK(_COLUMN_, _TYPE_, _WORDS_) ((_COLUMN_) + ((size_t) (_TYPE_) * (_WORDS_)))
+		#define CHUNK_RUN_PLACE(_MASK_, _BITS_, _BEGIN_) { \
+			uint64_t _bits_ = (_BITS_); \
+			int32_t _begin_ = (_BEGIN_); \
+			(_MASK_)[_begin_ / SECTION_WORD_BITS] |= (_bits_ << (_begin_ % SECTION_WORD_BITS)); \
+			if((_begin_ % SECTION_WORD_BITS) && (_bits_ >> (SECTION_WORD_BITS - (_begin_ % SECTION_WORD_BITS)))) { \
+				(_MASK_)[(_begin_ / SECTION_WORD_BITS) + 1] |= (_bits_ >> (SECTION_WORD_BITS \
+					- (_begin_ % SECTION_WORD_BITS))); \
+			} \
+			}
+		#define CHUNK_RUN_SET(_MASK_, _BIT_) \
+			((_MASK_)[(_BIT_) / SECTION_WORD_BITS] |= (1ULL << ((_BIT_) % SECTION_WORD_BITS)))
+		#define CHUNK_RUN_STRIDE(_WORDS_) ((size_t) (CRAFT_BLOCK_MAX + 1) * (_WORDS_))
+
+		#define CHUNK_SECTION_AT(_SECTION_, _X_, _Y_, _Z_, _DIMENSION_) \
+			((_SECTION_)[(_Y_) / CHUNK_SECTION_HEIGHT] ? (_SECTION_)[(_Y_) / CHUNK_SECTION_HEIGHT]->at( \
+			CHUNK_SECTION_INDEX(_X_, _Y_, _Z_, _DIMENSION_)) : CRAFT_BLOCK_AIR)
+		#define CHUNK_SECTION_COUNT(_HEIGHT_) \
+			(((uint32_t) (_HEIGHT_) + CHUNK_SECTION_HEIGHT - 1) / CHUNK_SECTION_HEIGHT)
+		#define CHUNK_SECTION_INDEX(_X_, _Y_, _Z_, _DIMENSION_) \
+			(((((uint32_t) (_Z_) * (uint32_t) (_DIMENSION_).x) + (uint32_t) (_X_)) * CHUNK_SECTION_HEIGHT) \
+			+ ((uint32_t) (_Y_) % CHUNK_SECTION_HEIGHT))
+		#define CHUNK_SECTION_LENGTH(_DIMENSION_) \
+			((uint32_t) (_DIMENSION_).x * (uint32_t) (_DIMENSION_).z * CHUNK_SECTION_HEIGHT)
+
+		#define SECTION_SLICE(_MASK_, _OFFSET_) \
+			(((_MASK_)[(_OFFSET_) / SECTION_WORD_BITS] >> ((_OFFSET_) % SECTION_WORD_BITS)) \
+			& ((1ULL << CHUNK_SECTION_HEIGHT) - 1))
+		#define SECTION_WORD_BITS 64
+
+		#define CHUNK_STREAM_ID(_POSITION_) \
+			((((uint32_t) (_POSITION_).y) << 16) | (((uint32_t) (_POSITION_).x) & UINT16_MAX))
+
+		#define CHUNK_VERSION_NONE UINT32_MAX
+
+		// corners of each face, wound counter-clockwise when seen from outside the block
+		static const uint8_t CHUNK_FACE_CORNER[CRAFT_FACE_MAX + 1][CHUNK_FACE_CORNERS][3] = {
+			{{0, 0, 0}, {0, 0, 1}, {0, 1, 1}, {0, 1, 0}},
+			{{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 1}},
+			{{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}},
+			{{0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {1, 1, 0}},
+			{{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 0, 0}},
+			{{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}},
+			};
+
+		static const uint8_t CHUNK_FACE_ORDER[CHUNK_FACE_VERTICES] = {
+			0, 1, 2, 0, 2, 3,
+			};
+
+		// axes of each face as {normal, width, height}, for sweeping its slices
+		static const uint8_t CHUNK_FACE_AXIS[CRAFT_FACE_MAX + 1][3] = {
+			{0, 2, 1}, {0, 2, 1}, {1, 0, 2}, {1, 0, 2}, {2, 0, 1}, {2, 0, 1},
+			};
+
+		static const int8_t CHUNK_FACE_NORMAL[CRAFT_FACE_MAX + 1][3] = {
+			{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1},
+			};
+
+		// occupancy planes of each block type: solid in the first, water in the second
+		static const uint8_t CHUNK_MASK_PLANE[CRAFT_BLOCK_MAX + 1] = {
+			0, 1, 2, 1, 1, 1, 1, 1, 1, 1,
+			};
+
+		_craft_chunk_section::_craft_chunk_section(
+			__in_opt uint32_t length,
+			__in_opt craft_block type
+			) :
+				m_bits(0),
+				m_length(length),
+				m_occupied((type != CRAFT_BLOCK_AIR) ? length : 0),
+				m_palette(1, type)
+		{
+			return;
+		}
+
+		_craft_chunk_section::_craft_chunk_section(
+			__in const _craft_chunk_section &other
+			) :
+				m_bits(other.m_bits),
+				m_length(other.m_length),
+				m_occupied(other.m_occupied),
+				m_palette(other.m_palette),
+				m_word(other.m_word)
+		{
+			return;
+		}
+
+		_craft_chunk_section::~_craft_chunk_section(void)
+		{
+			return;
+		}
+
+		_craft_chunk_section &
+		_craft_chunk_section::operator=(
+			__in const _craft_chunk_section &other
+			)
+		{
+
+			if(this != &other) {
+				m_bits = other.m_bits;
+				m_length = other.m_length;
+				m_occupied = other.m_occupied;
+				m_palette = other.m_palette;
+				m_word = other.m_word;
+			}
+
+			return *this;
+		}
+
+		craft_block 
+		_craft_chunk_section::at(
+			__in uint32_t index
+			) const
+		{
+			uint32_t offset;
+
+			if(!m_bits) {
+				return (craft_block) m_palette.front();
+			}
+
+			// widths divide the word size, so an index never straddles two words
+			offset = (index * m_bits);
+
+			return (craft_block) m_palette[(m_word[offset / SECTION_WORD_BITS] >> (offset % SECTION_WORD_BITS)) 
+				& ((1ULL << m_bits) - 1)];
+		}
+
+		uint32_t 
+		_craft_chunk_section::bits(void) const
+		{
+			return m_bits;
+		}
+
+		uint32_t 
+		_craft_chunk_section::bits_for(
+			__in size_t count
+			)
+		{
+			uint32_t result = 0;
+
+			if(count > 16) {
+				result = 8;
+			} else if(count > 4) {
+				result = 4;
+			} else if(count > 2) {
+				result = 2;
+			} else if(count > 1) {
+				result = 1;
+			}
+
+			return result;
+		}
+
+		void 
+		_craft_chunk_section::decode(
+			__out uint8_t *output,
+			__in uint32_t index,
+			__in uint32_t count,
+			__in_opt uint32_t stride
+			) const
+		{
+			uint64_t mask;
+			uint32_t iter = 0, offset;
+
+			if(!m_bits) {
+				std::memset(output, m_palette.front(), count);
+			} else {
+				mask = ((1ULL << m_bits) - 1);
+				offset = (index * m_bits);
+
+				for(; iter < count; ++iter, offset += (stride * m_bits)) {
+					output[iter] = m_palette[(m_word[offset / SECTION_WORD_BITS] 
+						>> (offset % SECTION_WORD_BITS)) & mask];
+				}
+			}
+		}
+
+		bool 
+		_craft_chunk_section::is_uniform(
+			__in craft_block type
+			) const
+		{
+			// a section emptied by edits keeps its palette, so air is judged by the occupied count
+			return ((!m_bits && (m_palette.front() == type)) || ((type == CRAFT_BLOCK_AIR) && !m_occupied));
+		}
+
+		void 
+		_craft_chunk_section::mask(
+			__inout uint32_t *output,
+			__in uint32_t index,
+			__in uint32_t count,
+			__in const uint8_t *plane,
+			__in uint32_t planes
+			) const
+		{
+			uint64_t mask;
+			uint8_t entry[UINT8_MAX + 1], flags;
+			uint32_t iter = 0, iter_plane, offset;
+
+			if(!m_bits) {
+
+				for(; iter < planes; ++iter) {
+
+					if(plane[m_palette.front()] & (1 << iter)) {
+						output[iter] |= ((count < 32) ? ((1U << count) - 1) : UINT32_MAX);
+					}
+				}
+			} else {
+
+				// the palette is resolved to planes once, so each entry costs a single lookup
+				for(; iter < m_palette.size(); ++iter) {
+					entry[iter] = plane[m_palette[iter]];
+				}
+
+				mask = ((1ULL << m_bits) - 1);
+				offset = (index * m_bits);
+
+				for(iter = 0; iter < count; ++iter, offset += m_bits) {
+					flags = entry[(m_word[offset / SECTION_WORD_BITS] >> (offset % SECTION_WORD_BITS)) & mask];
+
+					for(iter_plane = 0; iter_plane < planes; ++iter_plane) {
+						output[iter_plane] |= (((flags >> iter_plane) & 1U) << iter);
+					}
+				}
+			}
+		}
+
+		void 
+		_craft_chunk_section::pack(
+			__in const uint8_t *block,
+			__in uint32_t length
+			)
+		{
+			uint64_t word = 0;
+			uint32_t iter = 0, offset, position = 0;
+			int16_t entry[UINT8_MAX + 1];
+
+			m_length = length;
+			m_occupied = 0;
+			m_palette.clear();
+			m_word.clear();
+			std::fill(entry, entry + (UINT8_MAX + 1), -1);
+
+			// palette entries keep their first-seen order
+			for(; iter < length; ++iter) {
+
+				if(entry[block[iter]] < 0) {
+					entry[block[iter]] = m_palette.size();
+					m_palette.push_back(block[iter]);
+				}
+
+				m_occupied += (block[iter] != CRAFT_BLOCK_AIR);
+			}
+
+			if(m_palette.empty()) {
+				m_palette.push_back(CRAFT_BLOCK_AIR);
+			}
+
+			m_bits = bits_for(m_palette.size());
+			if(m_bits) {
+				m_word.resize(((length * m_bits) + SECTION_WORD_BITS - 1) / SECTION_WORD_BITS);
+
+				// widths divide the word size, so each word is built in a register and stored once
+				for(iter = 0, offset = 0; iter < length; ++iter) {
+					word |= ((uint64_t) entry[block[iter]] << offset);
+					offset += m_bits;
+
+					if(offset == SECTION_WORD_BITS) {
+						m_word[position++] = word;
+						offset = 0;
+						word = 0;
+					}
+				}
+
+				if(offset) {
+					m_word[position] = word;
+				}
+			}
+		}
+
+		void 
+		_craft_chunk_section::pack(
+			__in const uint64_t *mask,
+			__in const uint64_t *present,
+			__in uint32_t columns,
+			__in uint32_t words,
+			__in uint32_t level
+			)
+		{
+			uint64_t slice, value;
+			const uint64_t *column;
+			uint32_t entry, iter = 0, occupied = 0, offset = (level * CHUNK_SECTION_HEIGHT), position, 
+				slot[CRAFT_BLOCK_MAX + 1], type = 0;
+
+			m_length = (columns * CHUNK_SECTION_HEIGHT);
+			m_occupied = 0;
+			m_palette.clear();
+			m_word.clear();
+
+			// entries follow type order, so air is entry zero whenever it is present
+			for(; type <= CRAFT_BLOCK_MAX; ++type) {
+
+				if(SECTION_SLICE(CHUNK_RUN_MASK(present, type, words), offset)) {
+					m_palette.push_back(type);
+				}
+			}
+
+			m_bits = bits_for(m_palette.size());
+			if(m_bits) {
+				m_word.resize(((m_length * m_bits) + SECTION_WORD_BITS - 1) / SECTION_WORD_BITS);
+
+				for(entry = 0; entry < m_palette.size(); ++entry) {
+					slot[entry] = (m_palette[entry] * words);
+				}
+
+				// no more than sixteen types exist, so a column's slice packs into at most one word, and 
+				// entry zero is left as the cleared bits
+				for(column = mask; iter < columns; ++iter, column += CHUNK_RUN_STRIDE(words)) {
+					value = 0;
+
+					for(entry = 1; entry < m_palette.size(); ++entry) {
+
+						slice = SECTION_SLICE(&column[slot[entry]], offset);
+						value |= (spread(slice, m_bits) * entry);
+						occupied += __builtin_popcountll(slice);
+					}
+
+					position = (iter * CHUNK_SECTION_HEIGHT * m_bits);
+					m_word[position / SECTION_WORD_BITS] |= (value << (position % SECTION_WORD_BITS));
+				}
+
+				m_occupied = occupied;
+			}
+
+			// entries past zero are never air, so the count above only misses a solid entry zero
+			if(m_palette.front() != CRAFT_BLOCK_AIR) {
+				m_occupied = m_length;
+			}
+		}
+
+		size_t 
+		_craft_chunk_section::resident(void) const
+		{
+			return (sizeof(*this) + m_palette.capacity() + (m_word.capacity() * sizeof(uint64_t)));
+		}
+
+		void 
+		_craft_chunk_section::set(
+			__in uint32_t index,
+			__in craft_block type
+			)
+		{
+			uint32_t offset;
+			size_t entry = 0;
+			craft_block previous = at(index);
+
+			// the occupied count tracks non-air blocks, so an emptied section is found without a scan
+			if((previous == CRAFT_BLOCK_AIR) && (type != CRAFT_BLOCK_AIR)) {
+				++m_occupied;
+			} else if((previous != CRAFT_BLOCK_AIR) && (type == CRAFT_BLOCK_AIR)) {
+				--m_occupied;
+			}
+
+			for(; entry < m_palette.size(); ++entry) {
+
+				if(m_palette[entry] == type) {
+					break;
+				}
+			}
+
+			if(entry == m_palette.size()) {
+				m_palette.push_back(type);
+
+				if(bits_for(m_palette.size()) > m_bits) {
+					widen(bits_for(m_palette.size()));
+				}
+			}
+
+			if(m_bits) {
+				offset = (index * m_bits);
+				m_word[offset / SECTION_WORD_BITS] &= ~(((1ULL << m_bits) - 1) << (offset % SECTION_WORD_BITS));
+				m_word[offset / SECTION_WORD_BITS] |= ((uint64_t) entry << (offset % SECTION_WORD_BITS));
+			}
+		}
+
+		uint64_t 
+		_craft_chunk_section::spread(
+			__in uint64_t slice,
+			__in uint32_t bits
+			)
+		{
+			uint64_t result = slice;
+
+			// bit n of the slice moves to bit (n * bits), leaving each entry's lane for a multiply to fill
+			if(bits == 2) {
+#if defined(__BMI2__)
+				result = _pdep_u64(result, 0x55555555ULL);
+#else
+				result = ((result | (result << 8)) & 0x00FF00FFULL);
+				result = ((result | (result << 4)) & 0x0F0F0F0FULL);
+				result = ((result | (result << 2)) & 0x33333333ULL);
+				result = ((result | (result << 1)) & 0x55555555ULL);
+#endif // __BMI2__
+			} else if(bits == 4) {
+#if defined(__BMI2__)
+				result = _pdep_u64(result, 0x1111111111111111ULL);
+#else
+				result = ((result | (result << 24)) & 0x000000FF000000FFULL);
+				result = ((result | (result << 12)) & 0x000F000F000F000FULL);
+				result = ((result | (result << 6)) & 0x0303030303030303ULL);
+				result = ((result | (result << 3)) & 0x1111111111111111ULL);
+#endif // __BMI2__
+			}
+
+			return result;
+		}
+
+		std::string 
+		_craft_chunk_section::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			result << CRAFT_CHUNK_SECTION_HEADER << " (LEN. " << m_length << ", BITS. " << m_bits 
+				<< ", PAL. " << m_palette.size() << ", SIZE. " << resident();
+
+			if(verbose) {
+				result << ", PTR. 0x" << SCALAR_AS_HEX(craft_chunk_section *, this);
+			}
+
+			result << ")";
+
+			return result.str();
+		}
+
+		void 
+		_craft_chunk_section::widen(
+			__in uint32_t bits
+			)
+		{
+			uint32_t iter = 0, offset = 0;
+			std::vector<uint64_t> word(((m_length * bits) + SECTION_WORD_BITS - 1) / SECTION_WORD_BITS, 0);
+
+			// a uniform section has every index on palette entry zero, which the zeroed words already hold
+			if(m_bits) {
+
+				for(; iter < m_length; ++iter, offset += bits) {
+					word[offset / SECTION_WORD_BITS] |= (((m_word[(iter * m_bits) / SECTION_WORD_BITS] 
+						>> ((iter * m_bits) % SECTION_WORD_BITS)) & ((1ULL << m_bits) - 1)) 
+						<< (offset % SECTION_WORD_BITS));
+				}
+			}
+
+			m_bits = bits;
+			m_word.swap(word);
+		}
+
 		_craft_chunk::_craft_chunk(
 			__in const glm::vec2 &position,
 			__in const glm::vec3 &dimension,
-			__in const std::vector<uint8_t> &height
+			__in const std::vector<uint8_t> &height,
+			__in_opt const std::vector<craft_biome> &biome
 			) :
+				m_border(0),
+				m_changed(true),
+				m_mesh_mode(CRAFT_MESH_BINARY),
+				m_mesh_stats({0, 0, 0.0}),
+				m_version(0),
+				m_vertex_buffer_length(0)
+		{
+			initialize(position, dimension, height, biome);
+		}
+
+		_craft_chunk::_craft_chunk(void) :
+				m_border(0),
 				m_changed(true),
-				m_vertex_buffer(0),
+				m_mesh_mode(CRAFT_MESH_BINARY),
+				m_mesh_stats({0, 0, 0.0}),
+				m_version(0),
 				m_vertex_buffer_length(0)
 		{
-			initialize(position, dimension, height);
+			return;
 		}
 
 		_craft_chunk::_craft_chunk(
-			__in const _craft_chunk &other
+			__inout _craft_chunk &&other
 			) :
-				m_block(other.m_block),
+				m_biome(std::move(other.m_biome)),
+				m_border(other.m_border),
 				m_changed(other.m_changed),
 				m_dimension(other.m_dimension),
-				m_height(other.m_height),
+				m_height(std::move(other.m_height)),
+				m_mesh(std::move(other.m_mesh)),
+				m_mesh_block(std::move(other.m_mesh_block)),
+				m_mesh_column(std::move(other.m_mesh_column)),
+				m_mesh_mask(std::move(other.m_mesh_mask)),
+				m_mesh_mode(other.m_mesh_mode),
+				m_mesh_plane(std::move(other.m_mesh_plane)),
+				m_mesh_stats(other.m_mesh_stats),
 				m_position(other.m_position),
-				m_vertex_buffer(0),
-				m_vertex_buffer_length(0)
+				m_section(std::move(other.m_section)),
+				m_version(other.m_version),
+				m_vertex_buffer(std::move(other.m_vertex_buffer)),
+				m_vertex_buffer_length(other.m_vertex_buffer_length)
 		{
-			glGenBuffers(1, &m_vertex_buffer);
+			other.m_vertex_buffer_length = 0;
 		}
 
 		_craft_chunk::~_craft_chunk(void)
 		{
-
-			if(m_vertex_buffer) {
-				glDeleteBuffers(1, &m_vertex_buffer);
-				m_vertex_buffer = 0;
-			}
+			return;
 		}
 
 		_craft_chunk &
 		_craft_chunk::operator=(
-			__in const _craft_chunk &other
+			__inout _craft_chunk &&other
+			)
+		{
+
+			if(this != &other) {
+				m_biome = std::move(other.m_biome);
+				m_border = other.m_border;
+				m_changed = other.m_changed;
+				m_dimension = other.m_dimension;
+				m_height = std::move(other.m_height);
+				m_mesh = std::move(other.m_mesh);
+				m_mesh_block = std::move(other.m_mesh_block);
+				m_mesh_column = std::move(other.m_mesh_column);
+				m_mesh_mask = std::move(other.m_mesh_mask);
+				m_mesh_mode = other.m_mesh_mode;
+				m_mesh_plane = std::move(other.m_mesh_plane);
+				m_mesh_stats = other.m_mesh_stats;
+				m_position = other.m_position;
+				m_section = std::move(other.m_section);
+				m_version = other.m_version;
+				m_vertex_buffer = std::move(other.m_vertex_buffer);
+				m_vertex_buffer_length = other.m_vertex_buffer_length;
+				other.m_vertex_buffer_length = 0;
+			}
+
+			return *this;
+		}
+
+		void 
+		_craft_chunk::add_face(
+			__in uint32_t face,
+			__in uint8_t type,
+			__in const glm::uvec3 &origin,
+			__in const glm::uvec3 &extent
+			)
+		{
+			uint32_t vertex = 0;
+			const uint8_t *corner;
+
+			// face corners are unit offsets, so scaling them by the extent stretches the face over a rectangle
+			for(; vertex < CHUNK_FACE_VERTICES; ++vertex) {
+				corner = CHUNK_FACE_CORNER[face][CHUNK_FACE_ORDER[vertex]];
+				m_mesh.push_back(craft_uvec4{(uint8_t) (origin.x + (corner[0] * extent.x)), 
+					(uint8_t) (origin.y + (corner[1] * extent.y)), 
+					(uint8_t) (origin.z + (corner[2] * extent.z)), CHUNK_MESH_VERTEX(face, type)});
+			}
+
+			++m_mesh_stats.faces;
+		}
+
+		craft_block 
+		_craft_chunk::at(
+			__in const glm::vec3 &position
+			)
+		{
+			return find_block(position);
+		}
+
+		uint32_t 
+		_craft_chunk::border(void) const
+		{
+			return m_border;
+		}
+
+		void 
+		_craft_chunk::clear_border(void)
+		{
+			m_border = 0;
+		}
+
+		void 
+		_craft_chunk::column(
+			__out uint8_t *output,
+			__in const glm::vec2 &position
+			) const
+		{
+			uint32_t count, index, iter = 0;
+
+			if(!is_valid_height(position)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"{%f, %f}", position.x, position.y);
+			}
+
+			// a column is one contiguous run in each section it crosses
+			index = CHUNK_SECTION_INDEX(position.x, 0, position.y, m_dimension);
+
+			for(; iter < m_section.size(); ++iter) {
+				count = std::min((uint32_t) m_dimension.y - (iter * CHUNK_SECTION_HEIGHT), 
+					(uint32_t) CHUNK_SECTION_HEIGHT);
+
+				if(m_section[iter]) {
+					m_section[iter]->decode(output + (iter * CHUNK_SECTION_HEIGHT), index, count);
+				} else {
+					std::memset(output + (iter * CHUNK_SECTION_HEIGHT), CRAFT_BLOCK_AIR, count);
+				}
+			}
+		}
+
+		bool 
+		_craft_chunk::has_changed(void)
+		{
+			return m_changed;
+		}
+
+		glm::vec3 
+		_craft_chunk::dimension(void)
+		{
+			return m_dimension;
+		}
+
+		void 
+		_craft_chunk::fill_column(
+			__out uint64_t *mask,
+			__in uint32_t words,
+			__in int32_t top,
+			__inout uint8_t &height,
+			__in const glm::ivec3 &level,
+			__in const float *cave,
+			__in uint64_t step,
+			__in const uint32_t *variation
 			)
 		{
+			uint8_t layer;
+			uint32_t word;
+			uint64_t band, *carved = CHUNK_RUN_MASK(mask, CRAFT_BLOCK_AIR, words);
+			int32_t band_begin, band_end, begin, end, iter, next, segment, surface = height;
+
+			CHUNK_RUN_SET(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_BOUNDARY, words), 0);
+
+			if(surface < BLOCK_WATER_LEVEL) {
+				CHUNK_RUN_FILL(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_WATER, words), surface + 1, 
+					std::min((int32_t) BLOCK_WATER_LEVEL, top));
+			}
+
+			if(surface <= top) {
+
+				// a cave that opens at the surface lowers it, as long as the column stays above the water line
+				while((surface >= CAVE_FLOOR) && (surface > BLOCK_WATER_LEVEL) 
+						&& ((step >> (surface / CAVE_STEP_HEIGHT)) & 1) && CHUNK_CAVE_OPEN(cave, surface)) {
+					--surface;
+				}
+
+				height = surface;
+
+				if(surface > 0) {
+
+					if((surface < BLOCK_WATER_LEVEL) || (surface < level.z)) {
+						CHUNK_RUN_SET(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_SAND, words), surface);
+					} else if((surface < BLOCK_GRASS_LEVEL) || (surface < level.x)) {
+						CHUNK_RUN_SET(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_GRASS_SIDE, words), surface);
+					} else if(surface < level.y) {
+						CHUNK_RUN_SET(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_STONE, words), surface);
+					} else {
+						CHUNK_RUN_SET(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_SNOW_SIDE, words), surface);
+					}
+				}
+			}
+
+			// the column is solid from the floor up to its surface or the water line, so everything above is air, 
+			// and caves add the rest below
+			CHUNK_RUN_FILL(carved, std::max(std::min(surface, top), (surface < BLOCK_WATER_LEVEL) 
+				? std::min((int32_t) BLOCK_WATER_LEVEL, top) : 0) + 1, (int32_t) (words * SECTION_WORD_BITS) - 1);
+
+			end = std::min(surface - 1, top);
+			if(end < 1) {
+				return;
+			}
+
+			layer = (((surface < BLOCK_WATER_LEVEL) || (surface < level.z)) ? CRAFT_BLOCK_SAND : CRAFT_BLOCK_DIRT);
+			CHUNK_RUN_FILL(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_STONE, words), 1, 
+				std::min(end, surface - BLOCK_LAYER_VARIATION_MAX));
+
+			band_begin = std::max(1, surface - BLOCK_LAYER_VARIATION_MAX + 1);
+			band_end = std::min(end, surface - BLOCK_LAYER_VARIATION_MIN);
+
+			// only depths inside the variation band take a draw, and the band is gathered in a register 
+			// so its blocks land as one run per type
+			if(band_begin <= band_end) {
+
+				for(band = 0, iter = band_begin; iter <= band_end; ++iter) {
+					band |= ((uint64_t) ((surface - iter) 
+						< (int32_t) variation[surface - iter - BLOCK_LAYER_VARIATION_MIN]) << (iter - band_begin));
+				}
+
+				CHUNK_RUN_PLACE(CHUNK_RUN_MASK(mask, layer, words), band, band_begin);
+				CHUNK_RUN_PLACE(CHUNK_RUN_MASK(mask, CRAFT_BLOCK_STONE, words), 
+					~band & (~0ULL >> (SECTION_WORD_BITS - 1 - (band_end - band_begin))), band_begin);
+			}
+
+			CHUNK_RUN_FILL(CHUNK_RUN_MASK(mask, layer, words), std::max(1, surface - BLOCK_LAYER_VARIATION_MIN + 1), 
+				end);
+
+			// caves stay clear of the floor and of flooded columns, so no water sits on top of air
+			if((surface > BLOCK_WATER_LEVEL) && (end >= CAVE_FLOOR)) {
+
+				// only steps near the threshold somewhere in the cell are looked at, and of those the blend is 
+				// linear across a step, so a step whose ends agree is either all solid or all open
+				step &= ((~0ULL << (CAVE_FLOOR / CAVE_STEP_HEIGHT)) 
+					& (~0ULL >> ((SECTION_WORD_BITS - 1) - (end / CAVE_STEP_HEIGHT))));
+
+				for(; step; step &= (step - 1)) {
+					segment = CHUNK_MASK_CTZ(step);
+
+					if((std::max(cave[segment], cave[segment + 1]) + CHUNK_CAVE_MARGIN) <= CAVE_THRESHOLD) {
+						continue;
+					}
+
+					begin = std::max(segment * CAVE_STEP_HEIGHT, (int32_t) CAVE_FLOOR);
+					next = std::min((segment + 1) * CAVE_STEP_HEIGHT, end + 1);
+
+					if((std::min(cave[segment], cave[segment + 1]) - CHUNK_CAVE_MARGIN) > CAVE_THRESHOLD) {
+						CHUNK_RUN_FILL(carved, begin, next - 1);
+						continue;
+					}
+
+					// the whole step is blended at once, eight levels filling one register, and trimmed to the part 
+					// the column reaches
+#if defined(__AVX__)
+					band = (uint64_t) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(
+						_mm256_set1_ps(cave[segment]), _mm256_mul_ps(_mm256_set1_ps(cave[segment + 1] - cave[segment]), 
+						_mm256_div_ps(_mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_ps(CAVE_STEP_HEIGHT)))), 
+						_mm256_set1_ps(CAVE_THRESHOLD), _CMP_GT_OQ));
+#else
+					for(band = 0, iter = 0; iter < CAVE_STEP_HEIGHT; ++iter) {
+						band |= ((uint64_t) (CHUNK_CAVE_BLEND(cave[segment], cave[segment + 1], 
+							iter / (float) CAVE_STEP_HEIGHT) > CAVE_THRESHOLD) << iter);
+					}
+#endif // __AVX__
+
+					CHUNK_RUN_PLACE(carved, (band >> (begin - (segment * CAVE_STEP_HEIGHT))) 
+						& (~0ULL >> (SECTION_WORD_BITS - (next - begin))), begin);
+				}
+
+				// only the stone and layer runs reach below the surface, so only they are carved
+				for(word = 0; word < words; ++word) {
+					CHUNK_RUN_MASK(mask, CRAFT_BLOCK_STONE, words)[word] &= ~carved[word];
+					CHUNK_RUN_MASK(mask, layer, words)[word] &= ~carved[word];
+				}
+			}
+		}
+
+		craft_block 
+		_craft_chunk::find_block(
+			__in const glm::vec3 &position
+			) const
+		{
+			const craft_chunk_section *section;
+
+			if(!is_valid_position(position)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"{%f, %f, %f}", position.x, position.y, position.z);
+			}
+
+			section = m_section[(uint32_t) position.y / CHUNK_SECTION_HEIGHT].get();
+			if(!section) {
+				return CRAFT_BLOCK_AIR;
+			}
+
+			return section->at(CHUNK_SECTION_INDEX(position.x, position.y, position.z, m_dimension));
+		}
+
+		std::vector<uint8_t>::iterator 
+		_craft_chunk::find_height(
+			__in const glm::vec2 &position
+			)
+		{
+
+			if(!is_valid_height(position)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"{%f, %f}", position.x, position.y);
+			}
+
+			return (m_height.begin() + SCALAR_INDEX_2D(position.x, position.y, m_dimension.x));
+		}
+
+		uint8_t 
+		_craft_chunk::height_at(
+			__in const glm::vec2 &position
+			)
+		{
+			return *find_height(position);
+		}
+
+		void 
+		_craft_chunk::gather_blocks(
+			__in const std::vector<const _craft_chunk *> &neighbour
+			)
+		{
+			uint32_t iter, iter_column;
+			const _craft_chunk *adjacent;
+
+			// the padded volume holds this chunk plus one border column per side, with a solid floor below
+			// and air above, so every face test is a fixed offset away
+			m_mesh_block.assign(CHUNK_MESH_LENGTH(m_dimension), CRAFT_BLOCK_AIR);
+
+			for(iter = 0; iter < ((m_dimension.x + 2) * (m_dimension.z + 2)); ++iter) {
+				m_mesh_block[iter * ((size_t) m_dimension.y + 2)] = CRAFT_BLOCK_BOUNDARY;
+			}
+
+			for(iter = 0; iter < m_dimension.z; ++iter) {
+
+				for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+					column(&m_mesh_block[CHUNK_MESH_INDEX(iter_column, 0, iter, m_dimension)], 
+						glm::vec2(iter_column, iter));
+				}
+			}
+
+			// a missing neighbour leaves its border as air, so the edge of the world stays closed
+			for(iter = CRAFT_FACE_LEFT; (iter <= CRAFT_FACE_MAX) && (iter < neighbour.size()); ++iter) {
+
+				adjacent = neighbour[iter];
+				if(!adjacent || (adjacent->m_dimension != m_dimension)) {
+					continue;
+				}
+
+				switch(iter) {
+					case CRAFT_FACE_LEFT:
+
+						for(iter_column = 0; iter_column < m_dimension.z; ++iter_column) {
+							adjacent->column(&m_mesh_block[CHUNK_MESH_INDEX(-1, 0, iter_column, m_dimension)], 
+								glm::vec2(m_dimension.x - 1, iter_column));
+						}
+						break;
+					case CRAFT_FACE_RIGHT:
+
+						for(iter_column = 0; iter_column < m_dimension.z; ++iter_column) {
+							adjacent->column(&m_mesh_block[CHUNK_MESH_INDEX(m_dimension.x, 0, iter_column, 
+								m_dimension)], glm::vec2(0, iter_column));
+						}
+						break;
+					case CRAFT_FACE_BACK:
+
+						for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+							adjacent->column(&m_mesh_block[CHUNK_MESH_INDEX(iter_column, 0, -1, m_dimension)], 
+								glm::vec2(iter_column, m_dimension.z - 1));
+						}
+						break;
+					case CRAFT_FACE_FRONT:
+
+						for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+							adjacent->column(&m_mesh_block[CHUNK_MESH_INDEX(iter_column, 0, m_dimension.z, 
+								m_dimension)], glm::vec2(iter_column, 0));
+						}
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::gather_masks(
+			__in const std::vector<const _craft_chunk *> &neighbour,
+			__in const glm::uvec2 &range
+			)
+		{
+			glm::uvec2 section;
+			uint32_t iter, iter_column, words = CHUNK_MASK_WORDS(m_dimension.y);
+			const _craft_chunk *adjacent;
+
+			// masks are read straight from the sections that overlap the meshed range, without decoding blocks
+			section = {range.x / CHUNK_SECTION_HEIGHT, CHUNK_SECTION_COUNT(range.y)};
+			m_mesh_column.assign(CHUNK_MASK_COLUMN(((uint32_t) m_dimension.x + 2) 
+				* ((uint32_t) m_dimension.z + 2), words), 0);
+
+			for(iter = 0; iter < m_dimension.z; ++iter) {
+
+				for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+					mask_column(&m_mesh_column[CHUNK_MASK_COLUMN(((iter + 1) * ((uint32_t) m_dimension.x + 2)) 
+						+ iter_column + 1, words)], words, glm::uvec2(iter_column, iter), section);
+				}
+			}
+
+			for(iter = CRAFT_FACE_LEFT; (iter <= CRAFT_FACE_MAX) && (iter < neighbour.size()); ++iter) {
+
+				adjacent = neighbour[iter];
+				if(!adjacent || (adjacent->m_dimension != m_dimension)) {
+					continue;
+				}
+
+				switch(iter) {
+					case CRAFT_FACE_LEFT:
+
+						for(iter_column = 0; iter_column < m_dimension.z; ++iter_column) {
+							adjacent->mask_column(&m_mesh_column[CHUNK_MASK_COLUMN((iter_column + 1) 
+								* ((uint32_t) m_dimension.x + 2), words)], words, 
+								glm::uvec2(m_dimension.x - 1, iter_column), section);
+						}
+						break;
+					case CRAFT_FACE_RIGHT:
+
+						for(iter_column = 0; iter_column < m_dimension.z; ++iter_column) {
+							adjacent->mask_column(&m_mesh_column[CHUNK_MASK_COLUMN(((iter_column + 1) 
+								* ((uint32_t) m_dimension.x + 2)) + (uint32_t) m_dimension.x + 1, words)], words, 
+								glm::uvec2(0, iter_column), section);
+						}
+						break;
+					case CRAFT_FACE_BACK:
+
+						for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+							adjacent->mask_column(&m_mesh_column[CHUNK_MASK_COLUMN(iter_column + 1, words)], words, 
+								glm::uvec2(iter_column, m_dimension.z - 1), section);
+						}
+						break;
+					case CRAFT_FACE_FRONT:
+
+						for(iter_column = 0; iter_column < m_dimension.x; ++iter_column) {
+							adjacent->mask_column(&m_mesh_column[CHUNK_MASK_COLUMN((((uint32_t) m_dimension.z + 1) 
+								* ((uint32_t) m_dimension.x + 2)) + iter_column + 1, words)], words, 
+								glm::uvec2(iter_column, 0), section);
+						}
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::generate_blocks(void)
+		{
+			glm::uvec3 extent;
+			craft_random_stream stream;
+			glm::uvec3 iter = {0, 0, 0};
+			std::vector<float> cave;
+			std::vector<glm::ivec3> level;
+			std::vector<uint32_t> variation;
+			uint64_t *column;
+			std::vector<uint64_t> mask, present, step;
+			uint32_t cave_levels = CHUNK_CAVE_LEVELS(m_dimension.y);
+			uint32_t column_index, section_index, word, words;
+
+			// nothing above the highest column or the water line is solid, so those sections stay unallocated
+			extent = {m_dimension.x, 0, m_dimension.z};
+
+			for(std::vector<uint8_t>::iterator iter_height = m_height.begin(); iter_height != m_height.end(); 
+					++iter_height) {
+				extent.y = std::max(extent.y, (uint32_t) *iter_height + 1);
+			}
+
+			extent.y = std::min(std::max(extent.y, (uint32_t) BLOCK_WATER_LEVEL + 1), (uint32_t) m_dimension.y);
+			extent.y = std::min(CHUNK_SECTION_COUNT(extent.y) * CHUNK_SECTION_HEIGHT, (uint32_t) m_dimension.y);
+			words = CHUNK_MASK_WORDS(extent.y);
+			mask.assign((size_t) extent.x * extent.z * CHUNK_RUN_STRIDE(words), 0);
+			present.assign(CHUNK_RUN_STRIDE(words), 0);
+
+			// only depths inside the variation band depend on a draw, so each column takes one per depth
+			variation.resize(m_dimension.x * m_dimension.z * CHUNK_LAYER_VARIATION_SPAN);
+			stream = craft_random::acquire()->stream(CHUNK_STREAM_ID(m_position));
+			stream.generate_unsigned(&variation[0], variation.size(), BLOCK_LAYER_VARIATION_MIN, 
+				BLOCK_LAYER_VARIATION_MAX);
+			generate_caves(cave, step);
+			generate_levels(level);
+
+			// each column is written as a handful of runs into one bit mask per block type
+			for(iter.z = 0; iter.z < m_dimension.z; ++iter.z) {
+
+				for(iter.x = 0; iter.x < m_dimension.x; ++iter.x) {
+					column_index = SCALAR_INDEX_2D(iter.x, iter.z, m_dimension.x);
+					column = &mask[column_index * CHUNK_RUN_STRIDE(words)];
+					fill_column(column, words, extent.y - 1, m_height[column_index], level[column_index], 
+						&cave[column_index * cave_levels], step[column_index], 
+						&variation[column_index * CHUNK_LAYER_VARIATION_SPAN]);
+
+					// the union over every column tells each section which types it holds
+					for(word = 0; word < CHUNK_RUN_STRIDE(words); ++word) {
+						present[word] |= column[word];
+					}
+				}
+			}
+
+			// sections are packed straight from the column masks, so no block passes through a byte of its own
+			m_section.clear();
+			m_section.resize(CHUNK_SECTION_COUNT(m_dimension.y));
+
+			for(section_index = 0; section_index < CHUNK_SECTION_COUNT(extent.y); ++section_index) {
+				m_section[section_index].reset(new craft_chunk_section);
+				m_section[section_index]->pack(&mask[0], &present[0], extent.x * extent.z, words, section_index);
+
+				if(m_section[section_index]->is_uniform(CRAFT_BLOCK_AIR)) {
+					m_section[section_index].reset();
+				}
+			}
+
+			m_changed = true;
+		}
+
+		void 
+		_craft_chunk::generate_caves(
+			__out std::vector<float> &cave,
+			__out std::vector<uint64_t> &step
+			)
+		{
+			size_t index;
+			glm::vec2 fraction;
+			glm::uvec3 cell, count, iter;
+			const float *first, *second;
+			std::vector<uint64_t> cell_step;
+			std::vector<float> coarse, coarse_x, coarse_y, coarse_z;
+
+			count = {(((uint32_t) m_dimension.x + CAVE_STEP_WIDTH - 1) / CAVE_STEP_WIDTH) + 1, 
+				CHUNK_CAVE_LEVELS(m_dimension.y), 
+				(((uint32_t) m_dimension.z + CAVE_STEP_WIDTH - 1) / CAVE_STEP_WIDTH) + 1};
+			coarse_x.resize(count.x * count.y * count.z);
+			coarse_y.resize(coarse_x.size());
+			coarse_z.resize(coarse_x.size());
+
+			// the field is only sampled on a coarse lattice in world space, so neighbouring chunks line up
+			for(iter.z = 0; iter.z < count.z; ++iter.z) {
+
+				for(iter.y = 0; iter.y < count.y; ++iter.y) {
+
+					for(iter.x = 0; iter.x < count.x; ++iter.x) {
+						index = CHUNK_CAVE_INDEX(iter.x, iter.y, iter.z, count);
+						coarse_x[index] = ((m_position.x * m_dimension.x) + (iter.x * CAVE_STEP_WIDTH));
+						coarse_y[index] = (iter.y * CAVE_STEP_HEIGHT);
+						coarse_z[index] = ((m_position.y * m_dimension.z) + (iter.z * CAVE_STEP_WIDTH));
+					}
+				}
+			}
+
+			coarse.resize(coarse_x.size());
+			craft_simplex_3d::acquire()->generate(&coarse[0], &coarse_x[0], &coarse_y[0], &coarse_z[0], 
+				coarse.size(), CAVE_OCTAVES, CAVE_FREQUENCY, CAVE_PERSISTENCE);
+
+			// a blend stays within its corners, give or take rounding well inside the margin, so a step whose 
+			// corners all sit clear below the threshold is solid in every column of the cell
+			cell_step.assign((count.x - 1) * (count.z - 1), 0);
+
+			for(cell.z = 0; cell.z < (count.z - 1); ++cell.z) {
+
+				for(cell.x = 0; cell.x < (count.x - 1); ++cell.x) {
+
+					for(iter.y = 0; iter.y < count.y; ++iter.y) {
+
+						if((std::max(std::max(coarse[CHUNK_CAVE_INDEX(cell.x, iter.y, cell.z, count)], 
+								coarse[CHUNK_CAVE_INDEX(cell.x + 1, iter.y, cell.z, count)]), 
+								std::max(coarse[CHUNK_CAVE_INDEX(cell.x, iter.y, cell.z + 1, count)], 
+								coarse[CHUNK_CAVE_INDEX(cell.x + 1, iter.y, cell.z + 1, count)])) 
+								+ (2 * CHUNK_CAVE_MARGIN)) > CAVE_THRESHOLD) {
+							cell_step[(cell.z * (count.x - 1)) + cell.x] |= ((3ULL << iter.y) >> 1);
+						}
+					}
+				}
+			}
+
+			// each lattice row is blended along x once per column position, and since every column blends 
+			// along x first, the rows on either side of its cell are all it needs, level after level
+			coarse_x.resize(count.z * m_dimension.x * count.y);
+
+			for(iter.z = 0; iter.z < count.z; ++iter.z) {
+
+				for(iter.x = 0; iter.x < m_dimension.x; ++iter.x) {
+					cell.x = (iter.x / CAVE_STEP_WIDTH);
+					fraction.x = ((iter.x % CAVE_STEP_WIDTH) / (float) CAVE_STEP_WIDTH);
+					index = (((iter.z * (uint32_t) m_dimension.x) + iter.x) * count.y);
+
+					for(iter.y = 0; iter.y < count.y; ++iter.y) {
+						coarse_x[index + iter.y] = CHUNK_CAVE_BLEND(
+							coarse[CHUNK_CAVE_INDEX(cell.x, iter.y, iter.z, count)], 
+							coarse[CHUNK_CAVE_INDEX(cell.x + 1, iter.y, iter.z, count)], fraction.x);
+					}
+				}
+			}
+
+			// each column is blended across the lattice here, the blend along y is left to the fill
+			cave.resize(m_dimension.x * m_dimension.z * count.y);
+			step.resize(m_dimension.x * m_dimension.z);
+
+			for(iter.z = 0; iter.z < m_dimension.z; ++iter.z) {
+				cell.z = (iter.z / CAVE_STEP_WIDTH);
+				fraction.y = ((iter.z % CAVE_STEP_WIDTH) / (float) CAVE_STEP_WIDTH);
+
+				for(iter.x = 0; iter.x < m_dimension.x; ++iter.x) {
+					cell.x = (iter.x / CAVE_STEP_WIDTH);
+					index = SCALAR_INDEX_2D(iter.x, iter.z, m_dimension.x);
+
+					// a flooded column is never carved and no cave reaches above the surface, so the fill never 
+					// reads a level above the highest step left flagged
+					step[index] = ((m_height[index] > BLOCK_WATER_LEVEL) ? (cell_step[(cell.z * (count.x - 1)) 
+						+ cell.x] & (~0ULL >> ((SECTION_WORD_BITS - 1) - (m_height[index] / CAVE_STEP_HEIGHT)))) : 0);
+					first = &coarse_x[((cell.z * (uint32_t) m_dimension.x) + iter.x) * count.y];
+					second = (first + ((uint32_t) m_dimension.x * count.y));
+					index *= count.y;
+
+					for(iter.y = 0; iter.y < count.y; ++iter.y) {
+						cave[index + iter.y] = CHUNK_CAVE_BLEND(first[iter.y], second[iter.y], fraction.y);
+					}
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::generate_levels(
+			__out std::vector<glm::ivec3> &level
+			)
+		{
+			uint32_t iter = 0;
+			glm::ivec3 *column_level;
+			const craft_biome *biome;
+
+			level.resize(m_biome.size());
+
+			// wetter columns carry grass higher and colder ones bring the snow line down, while hot 
+			// and dry columns are sand down to the stone, so each column holds {stone, snow, sand}
+			for(; iter < m_biome.size(); ++iter) {
+				biome = &m_biome[iter];
+				column_level = &level[iter];
+				column_level->y = (BLOCK_STONE_LEVEL - CHUNK_BIOME_OFFSET(biome->temperature));
+				column_level->x = std::min(BLOCK_DIRT_LEVEL + CHUNK_BIOME_OFFSET(biome->moisture), 
+					column_level->y);
+				column_level->z = (((biome->temperature >= BIOME_DESERT_TEMPERATURE) 
+					&& (biome->moisture <= BIOME_DESERT_MOISTURE)) ? column_level->x : 0);
+			}
+		}
+
+		void 
+		_craft_chunk::initialize(
+			__in const glm::vec2 &position,
+			__in const glm::vec3 &dimension,
+			__in const std::vector<uint8_t> &height,
+			__in const std::vector<craft_biome> &biome
+			)
+		{
+
+			if((position.x < 0.0) || (position.y < 0.0)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"{%f, %f}", position.x, position.y);
+			}
+
+			// mesh vertices pack each coordinate into a byte, corners included
+			if((dimension.x <= 0.0) || (dimension.y <= 0.0) 
+					|| (dimension.z <= 0.0) || (dimension.x > UINT8_MAX) 
+					|| (dimension.y > UINT8_MAX) || (dimension.z > UINT8_MAX)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_DIMENSION,
+					"{%f, %f, %f}", dimension.x, dimension.y, dimension.z);
+			}
+
+			if(height.size() != (dimension.x * dimension.z)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_HEIGHT_MAP,
+					"%lu (should contain %lu entries)", height.size(), dimension.x * dimension.z);
+			}
+
+			if(!biome.empty() && (biome.size() != height.size())) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_BIOME_MAP,
+					"%lu (should contain %lu entries)", biome.size(), height.size());
+			}
+
+			m_position = position;
+			m_dimension = dimension;
+			m_height = height;
+
+			// a chunk without a biome map sits in a neutral biome, which keeps the fixed block levels
+			if(biome.empty()) {
+				m_biome.assign(height.size(), craft_biome{BIOME_NEUTRAL, BIOME_NEUTRAL});
+			} else {
+				m_biome = biome;
+			}
+
+			generate_blocks();
+			m_vertex_buffer.generate();
+		}
+
+		bool 
+		_craft_chunk::is_empty(
+			__in const glm::vec3 &position
+			)
+		{
+			return (at(position) == CRAFT_BLOCK_AIR);
+		}
+
+		bool 
+		_craft_chunk::is_valid_height(
+			__in const glm::vec2 &position
+			) const
+		{
+			return ((position.x >= 0.0) 
+				&& (position.y >= 0.0) 
+				&& (position.x < m_dimension.x) 
+				&& (position.y < m_dimension.z));
+		}
+
+		bool 
+		_craft_chunk::is_valid_position(
+			__in const glm::vec3 &position
+			) const
+		{
+			return ((position.x >= 0.0) 
+				&& (position.y >= 0.0) 
+				&& (position.z >= 0.0)
+				&& (position.x < m_dimension.x) 
+				&& (position.y < m_dimension.y) 
+				&& (position.z < m_dimension.z));
+		}
+
+		void 
+		_craft_chunk::layer(
+			__out uint8_t *output,
+			__in uint32_t level
+			) const
+		{
+
+			if(level >= m_dimension.y) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"%u (should be less than %u)", level, (uint32_t) m_dimension.y);
+			}
+
+			// a layer visits one block per column in {x, z} row order
+			if(m_section[level / CHUNK_SECTION_HEIGHT]) {
+				m_section[level / CHUNK_SECTION_HEIGHT]->decode(output, level % CHUNK_SECTION_HEIGHT, 
+					m_dimension.x * m_dimension.z, CHUNK_SECTION_HEIGHT);
+			} else {
+				std::memset(output, CRAFT_BLOCK_AIR, m_dimension.x * m_dimension.z);
+			}
+		}
+
+		void 
+		_craft_chunk::mask_clear(
+			__inout uint64_t *row,
+			__in uint32_t bit,
+			__in uint32_t count
+			)
+		{
+			uint32_t length, offset;
+
+			for(; count; bit += length, count -= length) {
+				offset = (bit % SECTION_WORD_BITS);
+				length = std::min(SECTION_WORD_BITS - offset, count);
+				row[bit / SECTION_WORD_BITS] &= ~((length == SECTION_WORD_BITS) ? UINT64_MAX 
+					: (((1ULL << length) - 1) << offset));
+			}
+		}
+
+		void 
+		_craft_chunk::mask_column(
+			__out uint64_t *output,
+			__in uint32_t words,
+			__in const glm::uvec2 &position,
+			__in const glm::uvec2 &section
+			) const
+		{
+			uint32_t iter = section.x, level, plane[CHUNK_MASK_PLANES];
+
+			// a section is as high as a quarter word, so its levels land inside a single word
+			for(; iter < section.y; ++iter) {
+
+				if(!m_section[iter]) {
+					continue;
+				}
+
+				plane[0] = 0;
+				plane[1] = 0;
+				level = (iter * CHUNK_SECTION_HEIGHT);
+				m_section[iter]->mask(plane, CHUNK_SECTION_INDEX(position.x, 0, position.y, m_dimension), 
+					std::min((uint32_t) m_dimension.y - level, (uint32_t) CHUNK_SECTION_HEIGHT), 
+					CHUNK_MASK_PLANE, CHUNK_MASK_PLANES);
+				output[level / SECTION_WORD_BITS] |= ((uint64_t) plane[0] << (level % SECTION_WORD_BITS));
+				output[words + (level / SECTION_WORD_BITS)] |= ((uint64_t) plane[1] << (level % SECTION_WORD_BITS));
+			}
+		}
+
+		uint32_t 
+		_craft_chunk::mask_run(
+			__in const uint64_t *row,
+			__in uint32_t bit,
+			__in uint32_t limit
+			)
+		{
+			uint64_t clear;
+			uint32_t length, offset, result = 0;
+
+			// the first clear bit past the start ends the run, which may carry on into the next word
+			while(result < limit) {
+				offset = ((bit + result) % SECTION_WORD_BITS);
+				clear = ~(row[(bit + result) / SECTION_WORD_BITS] >> offset);
+				length = (clear ? CHUNK_MASK_CTZ(clear) : SECTION_WORD_BITS);
+				result += length;
+
+				if(length < (SECTION_WORD_BITS - offset)) {
+					break;
+				}
+			}
+
+			return std::min(result, limit);
+		}
+
+		const craft_mesh_stats &
+		_craft_chunk::mesh(
+			__in_opt const std::vector<const _craft_chunk *> &neighbour
+			)
+		{
+			glm::uvec2 range;
+			std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+			// the output is cleared rather than released, so rebuilds reuse its storage
+			m_mesh.clear();
+			m_mesh_stats.faces = 0;
+
+			// only populated sections can hold a visible face
+			range = section_range();
+			range = {range.x * CHUNK_SECTION_HEIGHT, std::min(range.y * CHUNK_SECTION_HEIGHT, 
+				(uint32_t) m_dimension.y)};
+
+			if(range.x < range.y) {
+
+				switch(m_mesh_mode) {
+					case CRAFT_MESH_CULLED:
+						gather_blocks(neighbour);
+						mesh_culled(range);
+						break;
+					case CRAFT_MESH_GREEDY:
+						gather_blocks(neighbour);
+						mesh_greedy(range);
+						break;
+					case CRAFT_MESH_BINARY:
+						gather_masks(neighbour, range);
+						mesh_binary(range);
+						break;
+					default:
+						break;
+				}
+			}
+
+			m_mesh_stats.vertices = m_mesh.size();
+			m_mesh_stats.time = std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - begin).count();
+
+			return m_mesh_stats;
+		}
+
+		void 
+		_craft_chunk::mesh_binary(
+			__in const glm::uvec2 &range
+			)
+		{
+			glm::uvec3 position;
+			const uint64_t *other, *self;
+			uint64_t neighbour_solid, neighbour_water, visible;
+			uint32_t axis_normal, axis_row, column, face, iter, rows, slice, word;
+			uint32_t words = CHUNK_MASK_WORDS(m_dimension.y), words_row = CHUNK_MASK_WORDS(m_dimension.x);
+
+			// side faces compare whole columns, so each slice is a plane of column masks
+			for(face = CRAFT_FACE_LEFT; face <= CRAFT_FACE_MAX; ++face) {
+
+				if((face == CRAFT_FACE_BOTTOM) || (face == CRAFT_FACE_TOP)) {
+					continue;
+				}
+
+				axis_normal = CHUNK_FACE_AXIS[face][0];
+				axis_row = CHUNK_FACE_AXIS[face][1];
+				rows = (uint32_t) m_dimension[axis_row];
+				m_mesh_plane.resize(rows * words);
+				position = {0, 0, 0};
+
+				for(slice = 0; slice < (uint32_t) m_dimension[axis_normal]; ++slice) {
+					position[axis_normal] = slice;
+
+					for(iter = 0; iter < rows; ++iter) {
+						position[axis_row] = iter;
+						column = (((position.z + 1) * ((uint32_t) m_dimension.x + 2)) + position.x + 1);
+						self = &m_mesh_column[CHUNK_MASK_COLUMN(column, words)];
+						other = &m_mesh_column[CHUNK_MASK_COLUMN(column + CHUNK_FACE_NORMAL[face][0] 
+							+ (CHUNK_FACE_NORMAL[face][2] * ((int32_t) m_dimension.x + 2)), words)];
+
+						for(word = 0; word < words; ++word) {
+							m_mesh_plane[(iter * words) + word] = CHUNK_MASK_VISIBLE(self[word], self[words + word], 
+								other[word], other[words + word]);
+						}
+					}
+
+					mesh_plane(face, slice, &m_mesh_plane[0], rows, words, glm::uvec2(axis_row, 1));
+				}
+			}
+
+			// vertical faces compare a column with itself shifted by one level, then scatter into one plane per level
+			for(face = CRAFT_FACE_BOTTOM; face <= CRAFT_FACE_TOP; ++face) {
+				m_mesh_plane.assign((size_t) (range.y - range.x) * (uint32_t) m_dimension.z * words_row, 0);
+
+				for(position.z = 0; position.z < m_dimension.z; ++position.z) {
+
+					for(position.x = 0; position.x < m_dimension.x; ++position.x) {
+						column = (((position.z + 1) * ((uint32_t) m_dimension.x + 2)) + position.x + 1);
+						self = &m_mesh_column[CHUNK_MASK_COLUMN(column, words)];
+
+						for(word = 0; word < words; ++word) {
+
+							// the floor below the chunk is solid and the space above it is air
+							if(face == CRAFT_FACE_TOP) {
+								neighbour_solid = ((self[word] >> 1) | (((word + 1) < words) 
+									? (self[word + 1] << (SECTION_WORD_BITS - 1)) : 0));
+								neighbour_water = ((self[words + word] >> 1) | (((word + 1) < words) 
+									? (self[words + word + 1] << (SECTION_WORD_BITS - 1)) : 0));
+							} else {
+								neighbour_solid = ((self[word] << 1) | (word 
+									? (self[word - 1] >> (SECTION_WORD_BITS - 1)) : 1));
+								neighbour_water = ((self[words + word] << 1) | (word 
+									? (self[words + word - 1] >> (SECTION_WORD_BITS - 1)) : 0));
+							}
+
+							visible = CHUNK_MASK_VISIBLE(self[word], self[words + word], neighbour_solid, 
+								neighbour_water);
+
+							for(; visible; visible &= (visible - 1)) {
+								iter = ((word * SECTION_WORD_BITS) + CHUNK_MASK_CTZ(visible));
+								m_mesh_plane[((((size_t) iter - range.x) * (uint32_t) m_dimension.z + position.z) 
+									* words_row) + (position.x / SECTION_WORD_BITS)] |= 
+									(1ULL << (position.x % SECTION_WORD_BITS));
+							}
+						}
+					}
+				}
+
+				for(slice = range.x; slice < range.y; ++slice) {
+					mesh_plane(face, slice, &m_mesh_plane[((size_t) slice - range.x) * (uint32_t) m_dimension.z 
+						* words_row], (uint32_t) m_dimension.z, words_row, glm::uvec2(2, 0));
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::mesh_culled(
+			__in const glm::uvec2 &range
+			)
+		{
+			uint8_t type;
+			size_t index;
+			uint32_t face;
+			glm::uvec3 iter = {0, 0, 0};
+			int64_t offset[CRAFT_FACE_MAX + 1];
+
+			for(face = CRAFT_FACE_LEFT; face <= CRAFT_FACE_MAX; ++face) {
+				offset[face] = CHUNK_MESH_OFFSET(face, m_dimension);
+			}
+
+			for(iter.z = 0; iter.z < m_dimension.z; ++iter.z) {
+
+				for(iter.x = 0; iter.x < m_dimension.x; ++iter.x) {
+					index = CHUNK_MESH_INDEX(iter.x, range.x, iter.z, m_dimension);
+
+					for(iter.y = range.x; iter.y < range.y; ++iter.y, ++index) {
+
+						type = m_mesh_block[index];
+						if(type == CRAFT_BLOCK_AIR) {
+							continue;
+						}
+
+						for(face = CRAFT_FACE_LEFT; face <= CRAFT_FACE_MAX; ++face) {
+
+							if(CHUNK_FACE_VISIBLE(type, m_mesh_block[index + offset[face]])) {
+								add_face(face, type, iter, glm::uvec3(1, 1, 1));
+							}
+						}
+					}
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::mesh_greedy(
+			__in const glm::uvec2 &range
+			)
+		{
+			size_t index;
+			int64_t offset;
+			uint8_t neighbour, type;
+			glm::uvec3 extent, origin;
+			uint32_t lower[3] = {0, range.x, 0}, upper[3] = {(uint32_t) m_dimension.x, range.y, 
+				(uint32_t) m_dimension.z};
+			uint32_t axis_normal, axis_width, axis_height, face, height, iter_height, iter_width, 
+				length_height, length_width, position[3], run, width;
+			size_t stride[3] = {(size_t) m_dimension.y + 2, 1, ((size_t) m_dimension.x + 2) 
+				* ((size_t) m_dimension.y + 2)};
+
+			for(face = CRAFT_FACE_LEFT; face <= CRAFT_FACE_MAX; ++face) {
+				axis_normal = CHUNK_FACE_AXIS[face][0];
+				axis_width = CHUNK_FACE_AXIS[face][1];
+				axis_height = CHUNK_FACE_AXIS[face][2];
+				length_width = (upper[axis_width] - lower[axis_width]);
+				length_height = (upper[axis_height] - lower[axis_height]);
+				offset = CHUNK_MESH_OFFSET(face, m_dimension);
+				m_mesh_mask.resize(length_width * length_height);
+
+				for(position[axis_normal] = lower[axis_normal]; position[axis_normal] < upper[axis_normal]; 
+						++position[axis_normal]) {
+
+					// the mask holds the type of every visible face in this slice
+					position[axis_width] = lower[axis_width];
+					position[axis_height] = lower[axis_height];
+					index = CHUNK_MESH_INDEX(position[0], position[1], position[2], m_dimension);
+
+					for(iter_height = 0; iter_height < length_height; ++iter_height, index += stride[axis_height]) {
+
+						for(iter_width = 0; iter_width < length_width; ++iter_width) {
+							type = m_mesh_block[index + (iter_width * stride[axis_width])];
+							neighbour = m_mesh_block[index + (iter_width * stride[axis_width]) + offset];
+							m_mesh_mask[(iter_height * length_width) + iter_width] = (((type != CRAFT_BLOCK_AIR) 
+								&& CHUNK_FACE_VISIBLE(type, neighbour)) ? type : (uint8_t) CRAFT_BLOCK_AIR);
+						}
+					}
+
+					// each visible face grows as wide as its run, then as high as the whole run repeats
+					for(iter_height = 0; iter_height < length_height; ++iter_height) {
+
+						for(iter_width = 0; iter_width < length_width;) {
+
+							type = m_mesh_mask[(iter_height * length_width) + iter_width];
+							if(type == CRAFT_BLOCK_AIR) {
+								++iter_width;
+								continue;
+							}
+
+							for(width = 1; ((iter_width + width) < length_width) 
+									&& (m_mesh_mask[(iter_height * length_width) + iter_width + width] == type); 
+									++width);
+
+							for(height = 1; (iter_height + height) < length_height; ++height) {
+
+								index = ((iter_height + height) * length_width) + iter_width;
+								for(run = 0; (run < width) && (m_mesh_mask[index + run] == type); ++run);
+
+								if(run < width) {
+									break;
+								}
+							}
+
+							for(index = 0; index < height; ++index) {
+								std::memset(&m_mesh_mask[((iter_height + index) * length_width) + iter_width], 
+									CRAFT_BLOCK_AIR, width);
+							}
+
+							origin[axis_normal] = position[axis_normal];
+							origin[axis_width] = (lower[axis_width] + iter_width);
+							origin[axis_height] = (lower[axis_height] + iter_height);
+							extent[axis_normal] = 1;
+							extent[axis_width] = width;
+							extent[axis_height] = height;
+							add_face(face, type, origin, extent);
+							iter_width += width;
+						}
+					}
+				}
+			}
+		}
+
+		void 
+		_craft_chunk::mesh_plane(
+			__in uint32_t face,
+			__in uint32_t slice,
+			__inout uint64_t *plane,
+			__in uint32_t rows,
+			__in uint32_t words,
+			__in const glm::uvec2 &axis
+			)
+		{
+			uint8_t type;
+			glm::uvec3 extent, origin;
+			uint32_t bit, height, iter, row, width, word;
+			uint32_t position[3] = {0, 0, 0};
+
+			position[CHUNK_FACE_AXIS[face][0]] = slice;
+
+			for(row = 0; row < rows; ++row) {
+
+				for(word = 0; word < words; ++word) {
+
+					while(plane[(row * words) + word]) {
+						bit = ((word * SECTION_WORD_BITS) + CHUNK_MASK_CTZ(plane[(row * words) + word]));
+						position[axis.x] = row;
+						position[axis.y] = bit;
+						type = CHUNK_SECTION_AT(m_section, position[0], position[1], position[2], m_dimension);
+
+						// a run of set bits only merges while the block type holds
+						width = mask_run(&plane[row * words], bit, (words * SECTION_WORD_BITS) - bit);
+
+						for(iter = 1; iter < width; ++iter) {
+							position[axis.y] = (bit + iter);
+
+							if(CHUNK_SECTION_AT(m_section, position[0], position[1], position[2], m_dimension) 
+									!= type) {
+								break;
+							}
+						}
+
+						width = iter;
+
+						// following rows join while they repeat the whole run with the same type
+						for(height = 1; (row + height) < rows; ++height) {
+
+							if(mask_run(&plane[(row + height) * words], bit, width) < width) {
+								break;
+							}
+
+							position[axis.x] = (row + height);
+
+							for(iter = 0; iter < width; ++iter) {
+								position[axis.y] = (bit + iter);
+
+								if(CHUNK_SECTION_AT(m_section, position[0], position[1], position[2], m_dimension) 
+										!= type) {
+									break;
+								}
+							}
+
+							if(iter < width) {
+								break;
+							}
+						}
+
+						for(iter = 0; iter < height; ++iter) {
+							mask_clear(&plane[(row + iter) * words], bit, width);
+						}
+
+						origin[CHUNK_FACE_AXIS[face][0]] = slice;
+						origin[axis.y] = bit;
+						origin[axis.x] = row;
+						extent[CHUNK_FACE_AXIS[face][0]] = 1;
+						extent[axis.y] = width;
+						extent[axis.x] = height;
+						add_face(face, type, origin, extent);
+					}
+				}
+			}
+		}
+
+		craft_mesh_mode 
+		_craft_chunk::mesh_mode(void) const
+		{
+			return m_mesh_mode;
+		}
+
+		craft_mesh_stats 
+		_craft_chunk::mesh_stats(void) const
+		{
+			return m_mesh_stats;
+		}
+
+		std::vector<uint32_t> 
+		_craft_chunk::neighbour_version(
+			__in const std::vector<const _craft_chunk *> &neighbour
+			)
+		{
+			std::vector<uint32_t> result(neighbour.size(), CHUNK_VERSION_NONE);
+			uint32_t iter = 0;
+
+			for(; iter < neighbour.size(); ++iter) {
+
+				if(neighbour[iter]) {
+					result[iter] = neighbour[iter]->m_version;
+				}
+			}
+
+			return result;
+		}
+
+		glm::vec2 
+		_craft_chunk::position(void)
+		{
+			return m_position;
+		}
+
+		const craft_mesh_stats &
+		_craft_chunk::rebuild(
+			__in_opt const std::vector<const _craft_chunk *> &neighbour
+			)
+		{
+			mesh(neighbour);
+			upload_mesh();
+
+			return m_mesh_stats;
+		}
+
+		void 
+		_craft_chunk::render(
+			__in_opt GLuint attribute
+			)
+		{
+
+			// the uploaded mesh stays valid until the blocks change, so it is drawn every frame
+			if(m_vertex_buffer_length) {
+				glEnableVertexAttribArray(attribute);
+				glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer.id());
+				glVertexAttribIPointer(attribute, 4, GL_UNSIGNED_BYTE, 0, NULL);
+				glDrawArrays(GL_TRIANGLES, 0, m_vertex_buffer_length);
+				glDisableVertexAttribArray(attribute);
+			}
+		}
+
+		size_t 
+		_craft_chunk::resident(void) const
+		{
+			size_t result = 0;
+			std::vector<std::shared_ptr<craft_chunk_section>>::const_iterator iter = m_section.begin();
+
+			for(; iter != m_section.end(); ++iter) {
+				result += sizeof(*iter);
+
+				if(*iter) {
+					result += (*iter)->resident();
+				}
+			}
+
+			return result;
+		}
+
+		glm::uvec2 
+		_craft_chunk::section_range(void) const
+		{
+			glm::uvec2 result = {0, 0};
+			uint32_t iter = 0;
+
+			for(; iter < m_section.size(); ++iter) {
+
+				if(m_section[iter]) {
+
+					if(result.x == result.y) {
+						result.x = iter;
+					}
+
+					result.y = (iter + 1);
+				}
+			}
+
+			return result;
+		}
+
+		void 
+		_craft_chunk::set(
+			__in const glm::vec3 &position,
+			__in craft_block type
+			)
+		{
+			glm::vec3 pos;
+			std::vector<uint8_t>::iterator iter;
+			std::shared_ptr<craft_chunk_section> *section;
+
+			if(type > CRAFT_BLOCK_MAX) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_TYPE,
+					"0x%x", type);
+			}
+
+			if(!is_valid_position(position)) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
+					"{%f, %f, %f}", position.x, position.y, position.z);
+			}
+
+			iter = find_height({position.x, position.z});
+			// air written into an unallocated section is already there
+			section = &m_section[(uint32_t) position.y / CHUNK_SECTION_HEIGHT];
+			if(*section || (type != CRAFT_BLOCK_AIR)) {
+
+				if(!*section) {
+					section->reset(new craft_chunk_section(CHUNK_SECTION_LENGTH(m_dimension)));
+				} else if(section->use_count() > 1) {
+
+					// a section still held by an in-flight snapshot is copied before it is written
+					section->reset(new craft_chunk_section(**section));
+				}
+
+				(*section)->set(CHUNK_SECTION_INDEX(position.x, position.y, position.z, m_dimension), type);
+
+				// a section dug out to air is released, which also drops it from section_range
+				if((type == CRAFT_BLOCK_AIR) && (*section)->is_uniform(CRAFT_BLOCK_AIR)) {
+					section->reset();
+				}
+			}
+			pos = position;
 
-			if(this != &other) {
-				m_block = other.m_block;
-				m_changed = other.m_changed;
-				m_dimension = other.m_dimension;
-				m_height = other.m_height;
-				m_position = other.m_position;
+			while((type == CRAFT_BLOCK_AIR) && (pos.y == *iter)) {
+				pos.y -= 1.0;
+				*iter = (*iter - 1);
 			}
 
-			return *this;
-		}
+			// an edge block is also seen by the chunk across that edge, so its mesh goes stale too
+			if(!position.x) {
+				m_border |= (1 << CRAFT_FACE_LEFT);
+			} else if(position.x == (m_dimension.x - 1)) {
+				m_border |= (1 << CRAFT_FACE_RIGHT);
+			}
 
-		craft_block 
-		_craft_chunk::at(
-			__in const glm::vec3 &position
-			)
-		{
-			return (craft_block) find_block(position);
-		}
+			if(!position.z) {
+				m_border |= (1 << CRAFT_FACE_BACK);
+			} else if(position.z == (m_dimension.z - 1)) {
+				m_border |= (1 << CRAFT_FACE_FRONT);
+			}
 
-		bool 
-		_craft_chunk::has_changed(void)
-		{
-			return m_changed;
+			m_changed = true;
+			++m_version;
 		}
 
-		glm::vec3 
-		_craft_chunk::dimension(void)
+		void 
+		_craft_chunk::set_changed(void)
 		{
-			return m_dimension;
+			m_changed = true;
 		}
 
-		uint8_t &
-		_craft_chunk::find_block(
-			__in const glm::vec3 &position
+		void 
+		_craft_chunk::set_mesh_mode(
+			__in craft_mesh_mode mode
 			)
 		{
 
-			if(!is_valid_position(position)) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
-					"{%f, %f, %f}", position.x, position.y, position.z);
+			if(mode > CRAFT_MESH_MAX) {
+				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_TYPE,
+					"%x", mode);
 			}
 
-			return m_block[position.x][position.y][position.z];
+			if(mode != m_mesh_mode) {
+				m_mesh_mode = mode;
+				m_changed = true;
+				++m_version;
+			}
 		}
 
-		std::vector<uint8_t>::iterator 
-		_craft_chunk::find_height(
-			__in const glm::vec2 &position
-			)
+		_craft_chunk 
+		_craft_chunk::snapshot(void) const
 		{
+			_craft_chunk result;
 
-			if(!is_valid_height(position)) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
-					"{%f, %f}", position.x, position.y);
-			}
-
-			return (m_height.begin() + SCALAR_INDEX_2D(position.x, position.y, m_dimension.x));
-		}
+			// sections are shared rather than copied, since set copies any section a snapshot still holds
+			result.m_dimension = m_dimension;
+			result.m_mesh_mode = m_mesh_mode;
+			result.m_position = m_position;
+			result.m_section = m_section;
+			result.m_version = m_version;
 
-		uint8_t 
-		_craft_chunk::height_at(
-			__in const glm::vec2 &position
-			)
-		{
-			return *find_height(position);
+			return result;
 		}
 
 		void 
-		_craft_chunk::generate_blocks(void)
+		_craft_chunk::to_file(
+			__in const std::string &path,
+			__in const _craft_chunk &chunk,
+			__in_opt bool vertical
+			)
 		{
-			uint8_t height;
-			glm::uvec2 init;
-			craft_random *inst = NULL;
+			glm::uvec3 col;
+			std::stringstream output;
+			std::vector<uint8_t> row;
 			glm::ivec3 iter = {0, 0, 0};
 
-			m_block.resize(m_dimension.x);
-
-			for(init.x = 0; init.x < m_dimension.x; ++init.x) {
-				m_block[init.x].resize(m_dimension.y);
-
-				for(init.y = 0; init.y < m_dimension.y; ++init.y) {
-					m_block[init.x][init.y].resize(m_dimension.z, CRAFT_BLOCK_AIR);
-				}
-			}
+			row.resize(chunk.m_dimension.x * 3);
 
-			inst = craft_random::acquire();
+			if(vertical) {
 
-			for(iter.y = (m_dimension.y - 1.0); iter.y >= 0; iter.y--) {
+				for(iter.z = 0; iter.z < chunk.m_dimension.z; ++iter.z) {
+					output.clear();
+					output.str(std::string());
+					output << path << "_" << iter.z << craft_image_writer::extension(CRAFT_IMAGE_COLOR);
 
-				for(iter.z = 0; iter.z < m_dimension.z; ++iter.z) {
+					craft_image_writer file(output.str(), glm::uvec2(chunk.m_dimension.x, chunk.m_dimension.y), 
+						CRAFT_IMAGE_COLOR, PERLIN_SCALE_COLOR);
 
-					for(iter.x = 0; iter.x < m_dimension.x; ++iter.x) {
+					for(iter.y = (chunk.m_dimension.y - 1.0); iter.y >= 0; iter.y--) {
 
-						if(!iter.y) {
-							set(iter, CRAFT_BLOCK_BOUNDARY);
-							continue;
+						for(iter.x = 0; iter.x < chunk.m_dimension.x; ++iter.x) {
+							col = CRAFT_BLOCK_COLOR(chunk.find_block(glm::vec3(iter)));
+							row[iter.x * 3] = col.x;
+							row[(iter.x * 3) + 1] = col.y;
+							row[(iter.x * 3) + 2] = col.z;
 						}
 
-						height = *find_height({iter.x, iter.z});
-						if(height < iter.y) {
+						file.write(&row[0]);
+					}
 
-							if(iter.y <= BLOCK_WATER_LEVEL) {
-								set(iter, CRAFT_BLOCK_WATER);
-							}
+					file.close();
+				}
+			} else {
 
-							continue;
-						}
+				for(iter.y = (chunk.m_dimension.y - 1.0); iter.y >= 0; iter.y--) {
+					output.clear();
+					output.str(std::string());
+					output << path << "_" << iter.y << craft_image_writer::extension(CRAFT_IMAGE_COLOR);
 
-						if(height == iter.y) {
-
-							if(!height) {
-								set(iter, CRAFT_BLOCK_BOUNDARY);
-							} else if(height < BLOCK_WATER_LEVEL) {
-								set(iter, CRAFT_BLOCK_SAND);
-							} else if(height < BLOCK_GRASS_LEVEL) {
-								set(iter, CRAFT_BLOCK_GRASS_SIDE);
-							} else if(height < BLOCK_DIRT_LEVEL) {
-								set(iter, CRAFT_BLOCK_GRASS_SIDE);
-							} else if(height < BLOCK_STONE_LEVEL) {
-								set(iter, CRAFT_BLOCK_STONE);
-							} else {
-								set(iter, CRAFT_BLOCK_SNOW_SIDE);
-							}
-						} else {
+					craft_image_writer file(output.str(), glm::uvec2(chunk.m_dimension.x, chunk.m_dimension.z), 
+						CRAFT_IMAGE_COLOR, PERLIN_SCALE_COLOR);
 
-							if(height < (iter.y + inst->generate_unsigned(
-									BLOCK_LAYER_VARIATION_MIN, 
-									BLOCK_LAYER_VARIATION_MAX))) {
+					for(iter.z = 0; iter.z < chunk.m_dimension.z; ++iter.z) {
 
-								if(height < BLOCK_WATER_LEVEL) {
-									set(iter, CRAFT_BLOCK_SAND);
-								} else {
-									set(iter, CRAFT_BLOCK_DIRT);
-								}
-							} else {
-								set(iter, CRAFT_BLOCK_STONE);
-							}
+						for(iter.x = 0; iter.x < chunk.m_dimension.x; ++iter.x) {
+							col = CRAFT_BLOCK_COLOR(chunk.find_block(glm::vec3(iter)));
+							row[iter.x * 3] = col.x;
+							row[(iter.x * 3) + 1] = col.y;
+							row[(iter.x * 3) + 2] = col.z;
 						}
+
+						file.write(&row[0]);
 					}
+
+					file.close();
 				}
 			}
 		}
 
 		void 
-		_craft_chunk::initialize(
-			__in const glm::vec2 &position,
-			__in const glm::vec3 &dimension,
-			__in const std::vector<uint8_t> &height
+		_craft_chunk::to_map(
+			__out uint8_t *output,
+			__in size_t stride,
+			__in const _craft_chunk &chunk
 			)
 		{
+			int32_t top;
+			uint8_t *pixel;
+			glm::uvec3 col;
+			glm::uvec3 iter = {0, 0, 0};
+			std::vector<uint8_t> block(chunk.m_dimension.y);
 
-			if((position.x < 0.0) || (position.y < 0.0)) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_POSITION,
-					"{%f, %f}", position.x, position.y);
-			}
+			// one pixel per column, colored by the highest non-air block, which is water for flooded columns
+			for(; iter.y < chunk.m_dimension.z; ++iter.y) {
+				pixel = (output + (iter.y * stride));
 
-			if((dimension.x <= 0.0) || (dimension.y <= 0.0) 
-					|| (dimension.z <= 0.0)) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_DIMENSION,
-					"{%f, %f, %f}", dimension.x, dimension.y, dimension.z);
+				for(iter.x = 0; iter.x < chunk.m_dimension.x; ++iter.x, pixel += 3) {
+					top = std::min(std::max((int32_t) chunk.m_height[SCALAR_INDEX_2D(iter.x, iter.y, 
+						chunk.m_dimension.x)], BLOCK_WATER_LEVEL), (int32_t) chunk.m_dimension.y - 1);
+
+					chunk.column(&block[0], {iter.x, iter.y});
+
+					while((top > 0) && (block[top] == CRAFT_BLOCK_AIR)) {
+						--top;
+					}
+
+					col = CRAFT_BLOCK_COLOR((craft_block) block[top]);
+					pixel[0] = col.x;
+					pixel[1] = col.y;
+					pixel[2] = col.z;
+				}
 			}
+		}
 
-			if(height.size() != (dimension.x * dimension.z)) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_HEIGHT_MAP,
-					"%lu (should contain %lu entries)", height.size(), dimension.x * dimension.z);
+		std::string 
+		_craft_chunk::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			result << CRAFT_CHUNK_HEADER << " (POS. {" << m_position.x << ", " << m_position.y 
+				<< "}, DIM. {" << m_dimension.x << ", " << m_dimension.y 
+				<< ", " << m_dimension.z << "}";
+
+			if(verbose) {
+				result << ", MESH. {" << m_mesh_stats.faces << ", " << m_mesh_stats.vertices 
+					<< "} (" << m_mesh_stats.time << " ms), PTR. 0x" << SCALAR_AS_HEX(craft_chunk *, this);
 			}
 
-			m_position = position;
-			m_dimension = dimension;
-			m_height = height;
-			generate_blocks();
-			glGenBuffers(1, &m_vertex_buffer);
+			result << ")";
+
+			return result.str();
 		}
 
 		bool 
-		_craft_chunk::is_empty(
-			__in const glm::vec3 &position
+		_craft_chunk::upload(
+			__inout _craft_chunk &snapshot,
+			__in_opt const std::vector<const _craft_chunk *> &neighbour,
+			__in_opt const std::vector<uint32_t> &version
 			)
 		{
-			return (at(position) == CRAFT_BLOCK_AIR);
+			bool result = ((snapshot.m_version == m_version) && (neighbour_version(neighbour) == version));
+
+			// a mesh built before the latest edit here or across an edge is dropped, leaving the chunk 
+			// changed until a newer one lands
+			if(result) {
+				m_mesh.swap(snapshot.m_mesh);
+				m_mesh_stats = snapshot.m_mesh_stats;
+				upload_mesh();
+			}
+
+			return result;
 		}
 
-		bool 
-		_craft_chunk::is_valid_height(
-			__in const glm::vec2 &position
-			)
+		void 
+		_craft_chunk::upload_mesh(void)
 		{
-			return ((position.x >= 0.0) 
-				&& (position.y >= 0.0) 
-				&& (position.x < m_dimension.x) 
-				&& (position.y < m_dimension.z));
+			m_vertex_buffer_length = m_mesh.size();
+			if(m_vertex_buffer_length) {
+				glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer.id());
+				glBufferData(GL_ARRAY_BUFFER, m_mesh.size() * sizeof(craft_uvec4), (void *) &m_mesh[0], 
+					GL_STATIC_DRAW);
+			}
+
+			m_changed = false;
 		}
 
-		bool 
-		_craft_chunk::is_valid_position(
-			__in const glm::vec3 &position
-			)
+		uint32_t 
+		_craft_chunk::version(void) const
 		{
-			return ((position.x >= 0.0) 
-				&& (position.y >= 0.0) 
-				&& (position.z >= 0.0)
-				&& (position.x < m_dimension.x) 
-				&& (position.y < m_dimension.y) 
-				&& (position.z < m_dimension.z));
+			return m_version;
 		}
 
-		glm::vec2 
-		_craft_chunk::position(void)
+		_craft_chunk_pool::_craft_chunk_pool(void) :
+			m_complete(NULL),
+			m_initialized(false)
 		{
-			return m_position;
+			return;
 		}
 
-		void 
-		_craft_chunk::render(void)
+		_craft_chunk_pool::~_craft_chunk_pool(void)
 		{
 
-			if(m_changed && m_vertex_buffer_length) {
-				m_changed = false;
-				glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
-				glVertexAttribPointer(0, 4, GL_BYTE, GL_FALSE, 0, NULL);
-				glDrawArrays(GL_TRIANGLES, 0, m_vertex_buffer_length);
+			if(m_initialized) {
+				uninitialize();
 			}
 		}
 
-		void 
-		_craft_chunk::set(
-			__in const glm::vec3 &position,
-			__in craft_block type
+		size_t 
+		_craft_chunk_pool::collect(
+			__out std::vector<std::unique_ptr<craft_chunk_job>> &output
 			)
 		{
-			glm::vec3 pos;
-			std::vector<uint8_t>::iterator iter;
+			craft_chunk_job *job, *next, *ordered = NULL;
 
-			if(type > CRAFT_BLOCK_MAX) {
-				THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_INVALID_TYPE,
-					"0x%x", type);
+			if(!m_initialized) {
+				THROW_CRAFT_CHUNK_EXCEPTION(CRAFT_CHUNK_EXCEPTION_POOL_UNINITIALIZED);
 			}
 
-			iter = find_height({position.x, position.z});
-			find_block(position) = type;
-			pos = position;
+			output.clear();
 
-			while((type == CRAFT_BLOCK_AIR) && (pos.y == *iter)) {
-				pos.y -= 1.0;
-				*iter = (*iter - 1);
+			// the whole completion stack is taken at once, then reversed back into completion order
+			job = m_complete.exchange(NULL, std::memory_order_acquire);
+
+			for(; job; job = next) {
+				next = job->next;
+				job->next = ordered;
+				ordered = job;
 			}
 
-			m_changed = true;
+			for(; ordered; ordered = next) {
+				next = ordered->next;
+				ordered->next = NULL;
+				output.push_back(std::unique_ptr<craft_chunk_job>(ordered));
+			}
+
+			return output.size();
 		}
 
 		void 
-		_craft_chunk::to_file(
-			__in const std::string &path,
-			__in const _craft_chunk &chunk,
-			__in_opt bool vertical
+		_craft_chunk_pool::complete(
+			__in craft_chunk_job *job
 			)
 		{
-			glm::uvec3 col;
-			glm::ivec3 iter = {0, 0, 0};
-			std::stringstream output, result;
+			job->next = m_complete.load(std::memory_order_relaxed);
 
-			if(vertical) {
+			// workers only push and the main thread only takes the whole stack, so there is no ABA window
+			while(!m_complete.compare_exchange_weak(job->next, job, std::memory_order_release, 
+					std::memory_order_relaxed));
+		}
 
-				for(iter.z = 0; iter.z < chunk.m_dimension.z; ++iter.z) {
-					output.clear();
-					output.str(std::string());
-					output << path << "_" << iter.z << ".pbm";
+		void 
+		_craft_chunk_pool::initialize(
+			__in_opt uint32_t threads
+			)
+		{
+			uint32_t iter = 0;
 
-					std::fstream file(output.str().c_str(), std::ios::out);
-					if(!file) {
-						THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_FILE_NOT_FOUND,
-							"%s", STRING_CHECK(output.str()));
-					}
+			if(m_initialized) {
+				THROW_CRAFT_CHUNK_EXCEPTION(CRAFT_CHUNK_EXCEPTION_POOL_INITIALIZED);
+			}
 
-					result.clear();
-					result.str(std::string());
-					result << "P3" << std::endl << chunk.m_dimension.x << " " << chunk.m_dimension.y 
-						<< std::endl << PERLIN_SCALE_COLOR;
+			// one core is left to the render thread when the count is not given
+			if(!threads) {
+				threads = std::max(std::thread::hardware_concurrency(), (uint32_t) 2) - 1;
+			}
 
-					for(iter.y = (chunk.m_dimension.y - 1.0); iter.y >= 0; iter.y--) {
-						result << std::endl;
+			m_initialized = true;
 
-						for(iter.x = 0; iter.x < chunk.m_dimension.x; ++iter.x) {
+			for(; iter < threads; ++iter) {
+				m_worker.push_back(std::thread(&_craft_chunk_pool::run, this));
+			}
+		}
 
-							if(iter.x) {
-								result << " ";
-							}
+		bool 
+		_craft_chunk_pool::is_initialized(void) const
+		{
+			return m_initialized;
+		}
 
-							col = CRAFT_BLOCK_COLOR((craft_block) chunk.m_block[iter.x][iter.y][iter.z]);
-							result << col.x << " " << col.y << " " << col.z;
-						}
-					}
+		void 
+		_craft_chunk_pool::run(void)
+		{
+			craft_chunk_job *job;
 
-					file.write(result.str().c_str(), result.str().size());
-					file.close();
-				}
-			} else {
+			for(;;) {
 
-				for(iter.y = (chunk.m_dimension.y - 1.0); iter.y >= 0; iter.y--) {
-					output.clear();
-					output.str(std::string());
-					output << path << "_" << iter.y << ".pbm";
+				{
+					std::unique_lock<std::mutex> lock(m_queue_lock);
 
-					std::fstream file(output.str().c_str(), std::ios::out);
-					if(!file) {
-						THROW_CRAFT_CHUNK_EXCEPTION_FORMAT(CRAFT_CHUNK_EXCEPTION_FILE_NOT_FOUND,
-							"%s", STRING_CHECK(output.str()));
+					while(m_initialized && m_queue.empty()) {
+						m_condition.wait(lock);
 					}
 
-					result.clear();
-					result.str(std::string());
-					result << "P3" << std::endl << chunk.m_dimension.x << " " << chunk.m_dimension.z 
-						<< std::endl << PERLIN_SCALE_COLOR;
+					if(!m_initialized) {
+						break;
+					}
 
-					for(iter.z = 0; iter.z < chunk.m_dimension.z; ++iter.z) {
-						result << std::endl;
+					job = m_queue.front();
+					m_queue.pop_front();
+				}
 
-						for(iter.x = 0; iter.x < chunk.m_dimension.x; ++iter.x) {
+				try {
+					job->chunk->mesh(job->neighbour);
+				} catch(...) {
+					job->error = std::current_exception();
+				}
 
-							if(iter.x) {
-								result << " ";
-							}
+				complete(job);
+			}
+		}
 
-							col = CRAFT_BLOCK_COLOR((craft_block) chunk.m_block[iter.x][iter.y][iter.z]);
-							result << col.x << " " << col.y << " " << col.z;
-						}
-					}
+		void 
+		_craft_chunk_pool::submit(
+			__in const glm::vec2 &key,
+			__in const craft_chunk &chunk,
+			__in const std::vector<const craft_chunk *> &neighbour
+			)
+		{
+			uint32_t iter = 0;
+			std::unique_ptr<craft_chunk_job> job(new craft_chunk_job);
 
-					file.write(result.str().c_str(), result.str().size());
-					file.close();
+			if(!m_initialized) {
+				THROW_CRAFT_CHUNK_EXCEPTION(CRAFT_CHUNK_EXCEPTION_POOL_UNINITIALIZED);
+			}
+
+			// the job carries snapshots of the chunk and its neighbours, so later edits cannot reach the worker
+			job->key = key;
+			job->chunk.reset(new craft_chunk(chunk.snapshot()));
+			job->neighbour.assign(neighbour.size(), NULL);
+			job->version = craft_chunk::neighbour_version(neighbour);
+			job->next = NULL;
+
+			for(; iter < neighbour.size(); ++iter) {
+
+				if(neighbour[iter]) {
+					job->snapshot.push_back(std::unique_ptr<craft_chunk>(
+						new craft_chunk(neighbour[iter]->snapshot())));
+					job->neighbour[iter] = job->snapshot.back().get();
 				}
 			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_queue_lock);
+				m_queue.push_back(job.release());
+			}
+
+			m_condition.notify_one();
 		}
 
 		std::string 
-		_craft_chunk::to_string(
+		_craft_chunk_pool::to_string(
 			__in_opt bool verbose
 			)
 		{
 			std::stringstream result;
 
-			result << CRAFT_CHUNK_HEADER << " (POS. {" << m_position.x << ", " << m_position.y 
-				<< "}, DIM. {" << m_dimension.x << ", " << m_dimension.y 
-				<< ", " << m_dimension.z << "}";
+			result << CRAFT_CHUNK_POOL_HEADER << " (" << (m_initialized ? "INITIALIZED" : "UNINITIALIZED") 
+				<< ", THREADS. " << m_worker.size();
 
 			if(verbose) {
-				result << ", PTR. 0x" << SCALAR_AS_HEX(craft_chunk *, this);
+				result << ", PTR. 0x" << SCALAR_AS_HEX(craft_chunk_pool *, this);
 			}
 
 			result << ")";
@@ -438,22 +2276,37 @@ namespace CRAFT {
 		}
 
 		void 
-		_craft_chunk::update(
-			__in GLfloat delta
-			)
+		_craft_chunk_pool::uninitialize(void)
 		{
-			std::vector<craft_uvec4> data;
+			craft_chunk_job *job, *next;
 
-			// TODO: add chunk logic (falling blocks, etc.)
+			if(!m_initialized) {
+				THROW_CRAFT_CHUNK_EXCEPTION(CRAFT_CHUNK_EXCEPTION_POOL_UNINITIALIZED);
+			}
 
-			// TODO: add blocks data vector
+			{
+				std::lock_guard<std::mutex> lock(m_queue_lock);
+				m_initialized = false;
+			}
 
-			m_vertex_buffer_length = data.size();
-			if(m_vertex_buffer_length) {
-				glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
-				glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(craft_uvec4), (void *) &data[0], 
-					GL_STATIC_DRAW);
-				m_changed = true;
+			m_condition.notify_all();
+
+			for(std::vector<std::thread>::iterator iter = m_worker.begin(); iter != m_worker.end(); ++iter) {
+				iter->join();
+			}
+
+			m_worker.clear();
+
+			// queued and finished jobs are discarded, since their chunks are going away
+			for(std::deque<craft_chunk_job *>::iterator iter = m_queue.begin(); iter != m_queue.end(); ++iter) {
+				delete *iter;
+			}
+
+			m_queue.clear();
+
+			for(job = m_complete.exchange(NULL, std::memory_order_acquire); job; job = next) {
+				next = job->next;
+				delete job;
 			}
 		}
 	}
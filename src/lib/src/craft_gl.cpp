@@ -875,4 +875,92 @@ namespace CRAFT {
 		clear();
 		m_initialized = false;
 	}
+
+	_craft_gl_buffer::_craft_gl_buffer(void) :
+		m_id(0)
+	{
+		return;
+	}
+
+	_craft_gl_buffer::_craft_gl_buffer(
+		__inout _craft_gl_buffer &&other
+		) :
+			m_id(other.m_id)
+	{
+		other.m_id = 0;
+	}
+
+	_craft_gl_buffer::~_craft_gl_buffer(void)
+	{
+		release();
+	}
+
+	_craft_gl_buffer &
+	_craft_gl_buffer::operator=(
+		__inout _craft_gl_buffer &&other
+		)
+	{
+
+		if(this != &other) {
+			release();
+			m_id = other.m_id;
+			other.m_id = 0;
+		}
+
+		return *this;
+	}
+
+	void 
+	_craft_gl_buffer::generate(void)
+	{
+
+		if(!m_id) {
+
+			glGenBuffers(1, &m_id);
+			if(!m_id) {
+				THROW_CRAFT_GL_EXCEPTION_FORMAT(CRAFT_GL_EXCEPTION_EXTERNAL,
+					"%s", "glGenBuffers failed");
+			}
+		}
+	}
+
+	GLuint 
+	_craft_gl_buffer::id(void) const
+	{
+		return m_id;
+	}
+
+	bool 
+	_craft_gl_buffer::is_generated(void) const
+	{
+		return (m_id != 0);
+	}
+
+	void 
+	_craft_gl_buffer::release(void)
+	{
+
+		if(m_id) {
+			glDeleteBuffers(1, &m_id);
+			m_id = 0;
+		}
+	}
+
+	std::string 
+	_craft_gl_buffer::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_GL_HEADER << " (BUF. " << SCALAR_AS_HEX(GLuint, m_id);
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_gl_buffer *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
 }
@@ -0,0 +1,637 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "../include/craft.h"
+#include "../include/craft_image_type.h"
+
+namespace CRAFT {
+
+	#define IMAGE_BUFFER_LENGTH 65536
+	#define IMAGE_CHANNELS_COLOR 3
+	#define IMAGE_CHANNELS_GREYSCALE 1
+	#define IMAGE_GRADIENT_LENGTH 4096
+	#define IMAGE_HASH_OFFSET 0xcbf29ce484222325ULL
+	#define IMAGE_HASH_PRIME 0x100000001b3ULL
+	#define IMAGE_TILE_COMMENT "craft-tile "
+
+	static const std::string CRAFT_IMAGE_EXT[] = {
+		".pgm", ".ppm",
+		};
+
+	static const std::string CRAFT_IMAGE_MAGIC[] = {
+		"P5", "P6",
+		};
+
+	_craft_image_writer::_craft_image_writer(
+		__in const std::string &path,
+		__in const glm::uvec2 &dimension,
+		__in craft_image_format format,
+		__in_opt uint16_t maximum,
+		__in_opt const std::string &comment
+		) :
+			m_buffer_length(0),
+			m_channels(IMAGE_CHANNELS_GREYSCALE),
+			m_dimension(dimension),
+			m_format(format),
+			m_maximum(maximum),
+			m_path(path),
+			m_row(0)
+	{
+		std::stringstream header;
+
+		if(format > CRAFT_IMAGE_FORMAT_MAX) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_FORMAT,
+				"%x", format);
+		}
+
+		if(!dimension.x || !dimension.y) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_DIMENSION,
+				"{%u, %u}", dimension.x, dimension.y);
+		}
+
+		if(!maximum) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_DEPTH,
+				"%u", maximum);
+		}
+
+		if(format == CRAFT_IMAGE_COLOR) {
+			m_channels = IMAGE_CHANNELS_COLOR;
+		}
+
+		// the stream is unbuffered; rows are batched through m_buffer instead
+		m_file.rdbuf()->pubsetbuf(NULL, 0);
+		m_file.open(m_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!m_file) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_FILE_NOT_FOUND,
+				"%s", STRING_CHECK(m_path));
+		}
+
+		m_buffer.resize(IMAGE_BUFFER_LENGTH);
+		header << CRAFT_IMAGE_MAGIC[m_format] << std::endl;
+
+		if(!comment.empty()) {
+			header << "# " << comment << std::endl;
+		}
+
+		header << m_dimension.x << " " << m_dimension.y << std::endl << m_maximum << std::endl;
+		std::memcpy(reserve(header.str().size()), header.str().c_str(), header.str().size());
+	}
+
+	_craft_image_writer::~_craft_image_writer(void)
+	{
+
+		// destructors must not throw; call close to surface write errors
+		if(m_file.is_open()) {
+
+			if(m_buffer_length) {
+				m_file.write((char *) &m_buffer[0], m_buffer_length);
+				m_buffer_length = 0;
+			}
+
+			m_file.close();
+		}
+	}
+
+	void 
+	_craft_image_writer::close(void)
+	{
+
+		if(m_file.is_open()) {
+			flush();
+			m_file.close();
+
+			if(m_row != m_dimension.y) {
+				THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_ROW,
+					"%s: wrote %u of %u rows", STRING_CHECK(m_path), m_row, m_dimension.y);
+			}
+		}
+	}
+
+	std::string 
+	_craft_image_writer::extension(
+		__in craft_image_format format
+		)
+	{
+
+		if(format > CRAFT_IMAGE_FORMAT_MAX) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_FORMAT,
+				"%x", format);
+		}
+
+		return CRAFT_IMAGE_EXT[format];
+	}
+
+	void 
+	_craft_image_writer::flush(void)
+	{
+
+		if(m_buffer_length) {
+			m_file.write((char *) &m_buffer[0], m_buffer_length);
+			m_buffer_length = 0;
+
+			if(!m_file) {
+				THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_FILE_WRITE,
+					"%s", STRING_CHECK(m_path));
+			}
+		}
+	}
+
+	uint8_t *
+	_craft_image_writer::reserve(
+		__in size_t length
+		)
+	{
+		uint8_t *result;
+
+		if((m_buffer_length + length) > m_buffer.size()) {
+			flush();
+
+			if(length > m_buffer.size()) {
+				m_buffer.resize(length);
+			}
+		}
+
+		result = &m_buffer[m_buffer_length];
+		m_buffer_length += length;
+
+		return result;
+	}
+
+	uint32_t 
+	_craft_image_writer::row(void)
+	{
+		return m_row;
+	}
+
+	std::string 
+	_craft_image_writer::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_IMAGE_HEADER << " (" << CRAFT_IMAGE_MAGIC[m_format] << ", DIM. {" 
+			<< m_dimension.x << ", " << m_dimension.y << "}, MAX. " << m_maximum 
+			<< ", ROW " << m_row << "/" << m_dimension.y;
+
+		if(verbose) {
+			result << ", PATH. " << STRING_CHECK(m_path) 
+				<< ", PTR. 0x" << SCALAR_AS_HEX(craft_image_writer *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+
+	void 
+	_craft_image_writer::write(
+		__in const uint8_t *row
+		)
+	{
+		size_t length;
+
+		if(m_maximum > UINT8_MAX) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_DEPTH,
+				"%u (expecting 16-bit samples)", m_maximum);
+		}
+
+		if(!m_file.is_open() || (m_row >= m_dimension.y)) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_ROW,
+				"%u (should be less than %u)", m_row, m_dimension.y);
+		}
+
+		length = (m_dimension.x * m_channels);
+		std::memcpy(reserve(length), row, length);
+		++m_row;
+	}
+
+	void 
+	_craft_image_writer::write(
+		__in const uint16_t *row
+		)
+	{
+		uint8_t *output;
+		size_t iter = 0, length;
+
+		if(m_maximum <= UINT8_MAX) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_DEPTH,
+				"%u (expecting 8-bit samples)", m_maximum);
+		}
+
+		if(!m_file.is_open() || (m_row >= m_dimension.y)) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_ROW,
+				"%u (should be less than %u)", m_row, m_dimension.y);
+		}
+
+		// netpbm stores 16-bit samples most-significant byte first
+		length = (m_dimension.x * m_channels);
+		output = reserve(length * sizeof(uint16_t));
+
+		for(; iter < length; ++iter) {
+			output[iter * 2] = (row[iter] >> 8);
+			output[(iter * 2) + 1] = (row[iter] & UINT8_MAX);
+		}
+
+		++m_row;
+	}
+
+	_craft_tile_renderer::_craft_tile_renderer(
+		__in_opt uint32_t tile,
+		__in_opt uint32_t threads
+		) :
+			m_gradient(IMAGE_GRADIENT_LENGTH * IMAGE_CHANNELS_COLOR),
+			m_threads(threads),
+			m_tile(tile)
+	{
+		uint32_t iter = 0;
+
+		if(!tile) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_TILE,
+				"%u", tile);
+		}
+
+		if(!m_threads) {
+			m_threads = std::max(std::thread::hardware_concurrency(), (uint32_t) 1);
+		}
+
+		// the height-map gradient is sampled once so colorize is a table lookup per pixel
+		for(; iter < IMAGE_GRADIENT_LENGTH; ++iter) {
+			craft_perlin_2d::gradient_color(iter / (double) (IMAGE_GRADIENT_LENGTH - 1), 
+				&m_gradient[iter * IMAGE_CHANNELS_COLOR]);
+		}
+	}
+
+	_craft_tile_renderer::_craft_tile_renderer(
+		__in const _craft_tile_renderer &other
+		) :
+			m_gradient(other.m_gradient),
+			m_threads(other.m_threads),
+			m_tile(other.m_tile)
+	{
+		return;
+	}
+
+	_craft_tile_renderer::~_craft_tile_renderer(void)
+	{
+		return;
+	}
+
+	_craft_tile_renderer &
+	_craft_tile_renderer::operator=(
+		__in const _craft_tile_renderer &other
+		)
+	{
+
+		if(this != &other) {
+			m_gradient = other.m_gradient;
+			m_threads = other.m_threads;
+			m_tile = other.m_tile;
+		}
+
+		return *this;
+	}
+
+	void 
+	_craft_tile_renderer::colorize(
+		__out std::vector<uint8_t> &color,
+		__in const std::vector<double> &noise,
+		__in const glm::uvec2 &dimension
+		)
+	{
+		uint8_t *output;
+		const uint8_t *entry;
+		size_t iter = 0, length = ((size_t) dimension.x * dimension.y);
+
+		if(noise.size() < length) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_LENGTH,
+				"%lu (should be at least %lu)", noise.size(), length);
+		}
+
+		color.resize(length * IMAGE_CHANNELS_COLOR);
+		output = color.data();
+
+		for(; iter < length; ++iter, output += IMAGE_CHANNELS_COLOR) {
+			entry = &m_gradient[(uint32_t) ((std::min(std::max(0.0, noise[iter]), 1.0) 
+				* (IMAGE_GRADIENT_LENGTH - 1)) + 0.5) * IMAGE_CHANNELS_COLOR];
+			output[0] = entry[0];
+			output[1] = entry[1];
+			output[2] = entry[2];
+		}
+	}
+
+	void 
+	_craft_tile_renderer::downsample(
+		__out std::vector<uint8_t> &output,
+		__out glm::uvec2 &output_dimension,
+		__in const std::vector<uint8_t> &input,
+		__in const glm::uvec2 &input_dimension
+		)
+	{
+		uint8_t *pixel;
+		uint32_t channel, iter_x, iter_y = 0;
+		const uint8_t *top_left, *top_right, *bottom_left, *bottom_right;
+
+		output_dimension.x = ((input_dimension.x + 1) / 2);
+		output_dimension.y = ((input_dimension.y + 1) / 2);
+		output.resize((size_t) output_dimension.x * output_dimension.y * IMAGE_CHANNELS_COLOR);
+		pixel = output.data();
+
+		// odd edges repeat their last row or column rather than reading past the image
+		for(; iter_y < output_dimension.y; ++iter_y) {
+
+			for(iter_x = 0; iter_x < output_dimension.x; ++iter_x, pixel += IMAGE_CHANNELS_COLOR) {
+				top_left = &input[SCALAR_INDEX_2D((size_t) iter_x * 2, (size_t) iter_y * 2, 
+					input_dimension.x) * IMAGE_CHANNELS_COLOR];
+				top_right = &input[SCALAR_INDEX_2D((size_t) std::min((iter_x * 2) + 1, input_dimension.x - 1), 
+					(size_t) iter_y * 2, input_dimension.x) * IMAGE_CHANNELS_COLOR];
+				bottom_left = &input[SCALAR_INDEX_2D((size_t) iter_x * 2, (size_t) std::min((iter_y * 2) + 1, 
+					input_dimension.y - 1), input_dimension.x) * IMAGE_CHANNELS_COLOR];
+				bottom_right = &input[SCALAR_INDEX_2D((size_t) std::min((iter_x * 2) + 1, input_dimension.x - 1), 
+					(size_t) std::min((iter_y * 2) + 1, input_dimension.y - 1), input_dimension.x) 
+					* IMAGE_CHANNELS_COLOR];
+
+				for(channel = 0; channel < IMAGE_CHANNELS_COLOR; ++channel) {
+					pixel[channel] = ((top_left[channel] + top_right[channel] + bottom_left[channel] 
+						+ bottom_right[channel] + 2) / 4);
+				}
+			}
+		}
+	}
+
+	uint64_t 
+	_craft_tile_renderer::hash_tile(
+		__in const std::vector<uint8_t> &tile
+		)
+	{
+		uint64_t word;
+		size_t iter = 0;
+		uint64_t result = IMAGE_HASH_OFFSET;
+
+		// fnv-1a over whole words keeps the up-to-date check well below the cost of writing a tile
+		for(; (iter + sizeof(word)) <= tile.size(); iter += sizeof(word)) {
+			std::memcpy(&word, &tile[iter], sizeof(word));
+			result = ((result ^ word) * IMAGE_HASH_PRIME);
+		}
+
+		for(; iter < tile.size(); ++iter) {
+			result = ((result ^ tile[iter]) * IMAGE_HASH_PRIME);
+		}
+
+		return (result ^ (result >> 32));
+	}
+
+	bool 
+	_craft_tile_renderer::is_current(
+		__in const std::string &path,
+		__in const std::string &comment,
+		__in size_t length
+		)
+	{
+		std::string line;
+		std::streamoff data;
+		bool result = false;
+
+		std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+		if(file) {
+
+			// magic, comment, dimension and maximum lines; a truncated write fails the length check
+			std::getline(file, line);
+			std::getline(file, line);
+
+			if(file && (line == ("# " + comment))) {
+				std::getline(file, line);
+				std::getline(file, line);
+
+				if(file) {
+					data = file.tellg();
+					file.seekg(0, std::ios::end);
+					result = (file && ((file.tellg() - data) == (std::streamoff) length));
+				}
+			}
+		}
+
+		return result;
+	}
+
+	uint32_t 
+	_craft_tile_renderer::level_count(
+		__in const glm::uvec2 &dimension,
+		__in uint32_t tile
+		)
+	{
+		uint32_t result = 1, length = std::max(dimension.x, dimension.y);
+
+		if(!tile) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_TILE,
+				"%u", tile);
+		}
+
+		for(; length > tile; ++result) {
+			length = ((length + 1) / 2);
+		}
+
+		return result;
+	}
+
+	craft_tile_stats 
+	_craft_tile_renderer::render(
+		__in const std::string &path,
+		__in const std::vector<uint8_t> &color,
+		__in const glm::uvec2 &dimension
+		)
+	{
+		std::stringstream prefix;
+		std::vector<std::thread> worker;
+		craft_tile_stats result = {0, 0, 0};
+		const std::vector<uint8_t> *current = &color;
+		std::vector<uint8_t> level_color[2];
+		std::vector<std::exception_ptr> error;
+		std::atomic<uint32_t> next, rendered, skipped;
+		glm::uvec2 current_dimension = dimension, next_dimension;
+		uint32_t count, iter_level = 0, iter_worker, threads;
+
+		if(!dimension.x || !dimension.y) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_DIMENSION,
+				"{%u, %u}", dimension.x, dimension.y);
+		}
+
+		if(color.size() < ((size_t) dimension.x * dimension.y * IMAGE_CHANNELS_COLOR)) {
+			THROW_CRAFT_IMAGE_EXCEPTION_FORMAT(CRAFT_IMAGE_EXCEPTION_INVALID_LENGTH,
+				"%lu (should be at least %lu)", color.size(), 
+				(size_t) dimension.x * dimension.y * IMAGE_CHANNELS_COLOR);
+		}
+
+		rendered = 0;
+		skipped = 0;
+		result.levels = level_count(dimension, m_tile);
+
+		for(; iter_level < result.levels; ++iter_level) {
+			prefix.clear();
+			prefix.str(std::string());
+			prefix << path << "_" << iter_level;
+
+			next = 0;
+			count = (((current_dimension.x + m_tile - 1) / m_tile) 
+				* ((current_dimension.y + m_tile - 1) / m_tile));
+			threads = std::min(m_threads, count);
+			error.assign(threads, std::exception_ptr());
+
+			// tiles are handed out one at a time, so skipped tiles do not leave a worker idle
+			for(iter_worker = 1; iter_worker < threads; ++iter_worker) {
+				worker.push_back(std::thread(render_tiles, prefix.str(), std::cref(*current), 
+					current_dimension, m_tile, std::ref(next), std::ref(rendered), std::ref(skipped), 
+					std::ref(error[iter_worker])));
+			}
+
+			render_tiles(prefix.str(), *current, current_dimension, m_tile, next, rendered, skipped, 
+				error.front());
+
+			for(std::vector<std::thread>::iterator iter = worker.begin(); iter != worker.end(); ++iter) {
+				iter->join();
+			}
+
+			worker.clear();
+
+			for(std::vector<std::exception_ptr>::iterator iter = error.begin(); iter != error.end(); 
+					++iter) {
+
+				if(*iter) {
+					std::rethrow_exception(*iter);
+				}
+			}
+
+			if((iter_level + 1) < result.levels) {
+				downsample(level_color[iter_level % 2], next_dimension, *current, current_dimension);
+				current = &level_color[iter_level % 2];
+				current_dimension = next_dimension;
+			}
+		}
+
+		result.rendered = rendered;
+		result.skipped = skipped;
+
+		return result;
+	}
+
+	craft_tile_stats 
+	_craft_tile_renderer::render(
+		__in const std::string &path,
+		__in const std::vector<double> &noise,
+		__in const glm::uvec2 &dimension
+		)
+	{
+		std::vector<uint8_t> color;
+
+		colorize(color, noise, dimension);
+
+		return render(path, color, dimension);
+	}
+
+	void 
+	_craft_tile_renderer::render_tiles(
+		__in const std::string &path,
+		__in const std::vector<uint8_t> &color,
+		__in const glm::uvec2 &dimension,
+		__in uint32_t tile,
+		__inout std::atomic<uint32_t> &next,
+		__inout std::atomic<uint32_t> &rendered,
+		__inout std::atomic<uint32_t> &skipped,
+		__out std::exception_ptr &error
+		)
+	{
+		glm::uvec2 origin, span;
+		std::vector<uint8_t> pixel;
+		std::stringstream comment, output;
+		uint32_t count, columns, index, iter_y;
+		size_t length = ((size_t) tile * tile * IMAGE_CHANNELS_COLOR);
+
+		columns = ((dimension.x + tile - 1) / tile);
+		count = (columns * ((dimension.y + tile - 1) / tile));
+
+		try {
+
+			for(index = next++; index < count; index = next++) {
+				origin = {(index % columns) * tile, (index / columns) * tile};
+				span = {std::min(tile, dimension.x - origin.x), std::min(tile, dimension.y - origin.y)};
+
+				// edge tiles are padded to the full tile size with black
+				pixel.assign(length, 0);
+
+				for(iter_y = 0; iter_y < span.y; ++iter_y) {
+					std::memcpy(&pixel[(size_t) iter_y * tile * IMAGE_CHANNELS_COLOR], 
+						&color[SCALAR_INDEX_2D((size_t) origin.x, (size_t) origin.y + iter_y, dimension.x) 
+						* IMAGE_CHANNELS_COLOR], (size_t) span.x * IMAGE_CHANNELS_COLOR);
+				}
+
+				comment.clear();
+				comment.str(std::string());
+				comment << IMAGE_TILE_COMMENT << SCALAR_AS_HEX(uint64_t, hash_tile(pixel));
+
+				output.clear();
+				output.str(std::string());
+				output << path << "_" << (index % columns) << "_" << (index / columns) 
+					<< craft_image_writer::extension(CRAFT_IMAGE_COLOR);
+
+				if(is_current(output.str(), comment.str(), length)) {
+					++skipped;
+					continue;
+				}
+
+				craft_image_writer file(output.str(), glm::uvec2(tile, tile), CRAFT_IMAGE_COLOR, 
+					PERLIN_SCALE_COLOR, comment.str());
+
+				for(iter_y = 0; iter_y < tile; ++iter_y) {
+					file.write(&pixel[(size_t) iter_y * tile * IMAGE_CHANNELS_COLOR]);
+				}
+
+				file.close();
+				++rendered;
+			}
+		} catch(...) {
+			error = std::current_exception();
+		}
+	}
+
+	uint32_t 
+	_craft_tile_renderer::tile(void)
+	{
+		return m_tile;
+	}
+
+	std::string 
+	_craft_tile_renderer::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_TILE_RENDERER_HEADER << " (TILE. " << m_tile << ", THREADS. " << m_threads 
+			<< ", GRADIENT. " << (m_gradient.size() / IMAGE_CHANNELS_COLOR);
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_tile_renderer *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+}
@@ -18,11 +18,355 @@
  */
 
 #include <fstream>
+#include <limits>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif // __AVX__ || __SSE2__
 #include "../include/craft.h"
 #include "../include/craft_random_type.h"
 
 namespace CRAFT {
 
+	#define HASH_NOISE_MIX_0 0xbf58476d1ce4e5b9ULL
+	#define HASH_NOISE_MIX_1 0x94d049bb133111ebULL
+	#define HASH_NOISE_SCALE (1.0 / 9007199254740992.0)
+	#define HASH_NOISE_STEP 0x9e3779b97f4a7c15ULL
+
+	#define NOISE_ABS_MASK 0x7fffffffffffffffLL
+	#define NOISE_LEVEL_LENGTH(_LENGTH_, _LEVEL_) \
+		(((_LENGTH_) + (1U << (_LEVEL_)) - 1) >> (_LEVEL_))
+	#define NOISE_LEVEL_MAX 31
+	#define NOISE_MEAN 0.5
+	#define NOISE_STRIP_LENGTH 8192
+
+	#define PHILOX_BATCH 2
+	#define PHILOX_LANES 4
+	#define PHILOX_MUL_0 0xd2511f53U
+	#define PHILOX_MUL_1 0xcd9e8d57U
+	#define PHILOX_ROUNDS 10
+	#define PHILOX_WEYL_0 0x9e3779b9U
+	#define PHILOX_WEYL_1 0xbb67ae85U
+	#define PHILOX_WORDS 4
+
+	#define STREAM_FLOAT_SCALE (1.0 / 9007199254740992.0)
+
+	typedef struct _craft_perlin_exact {
+
+		static inline double blend(
+			__in double value,
+			__in double weight
+			)
+		{
+			return (value * weight);
+		}
+
+#if defined(__AVX__)
+		static inline __m256d blend(
+			__in __m256d value,
+			__in __m256d weight
+			)
+		{
+			return _mm256_mul_pd(value, weight);
+		}
+#elif defined(__SSE2__)
+		static inline __m128d blend(
+			__in __m128d value,
+			__in __m128d weight
+			)
+		{
+			return _mm_mul_pd(value, weight);
+		}
+#endif // __AVX__ || __SSE2__
+
+		static inline double line(
+			__in double value
+			)
+		{
+			return value;
+		}
+	} craft_perlin_exact;
+
+	// the cosine and linear policies keep the single-precision rounding of the original vec3 
+	// interpolation, so their output is unchanged
+	typedef struct _craft_perlin_cosine : public craft_perlin_exact {
+
+		static inline double fade(
+			__in double alpha
+			)
+		{
+			return ((1.0 - std::cos(alpha * M_PI)) * 0.5);
+		}
+
+		static inline double line(
+			__in double value
+			)
+		{
+			return (float) value;
+		}
+	} craft_perlin_cosine;
+
+	typedef struct _craft_perlin_hermite : public craft_perlin_exact {
+
+		static inline double fade(
+			__in double alpha
+			)
+		{
+			return (alpha * alpha * (3.0 - (2.0 * alpha)));
+		}
+	} craft_perlin_hermite;
+
+	typedef struct _craft_perlin_linear : public craft_perlin_cosine {
+
+		static inline double blend(
+			__in double value,
+			__in double weight
+			)
+		{
+			return (float) (value * weight);
+		}
+
+#if defined(__AVX__)
+		static inline __m256d blend(
+			__in __m256d value,
+			__in __m256d weight
+			)
+		{
+			return _mm256_cvtps_pd(_mm256_cvtpd_ps(_mm256_mul_pd(value, weight)));
+		}
+#elif defined(__SSE2__)
+		static inline __m128d blend(
+			__in __m128d value,
+			__in __m128d weight
+			)
+		{
+			return _mm_cvtps_pd(_mm_cvtpd_ps(_mm_mul_pd(value, weight)));
+		}
+#endif // __AVX__ || __SSE2__
+
+		static inline double fade(
+			__in double alpha
+			)
+		{
+			return alpha;
+		}
+	} craft_perlin_linear;
+
+	typedef struct _craft_perlin_quintic : public craft_perlin_exact {
+
+		static inline double fade(
+			__in double alpha
+			)
+		{
+			return (alpha * alpha * alpha * ((alpha * ((alpha * 6.0) - 15.0)) + 10.0));
+		}
+	} craft_perlin_quintic;
+
+	template <typename T> struct _craft_perlin_band_task {
+		void (*generate)(T *, craft_perlin_band &, const double *, uint32_t, craft_perlin_layout, 
+			const glm::uvec2 &, uint32_t, const glm::ivec2 &, uint32_t, uint32_t, uint32_t, double, double, 
+			craft_perlin_mode, uint32_t, const double *);
+		T *output;
+		craft_perlin_band *band;
+		const double *scale;
+		uint32_t channels;
+		craft_perlin_layout layout;
+		glm::uvec2 dimension;
+		uint32_t level;
+		glm::ivec2 base;
+		glm::uvec2 sample;
+		uint32_t rows;
+		uint32_t stride;
+		uint32_t octaves;
+		double amplitude;
+		double persistence;
+		craft_perlin_mode mode;
+		uint32_t seed;
+		const double *rough;
+	};
+
+	_craft_perlin_pool::_craft_perlin_pool(void) :
+		m_context(NULL),
+		m_count(0),
+		m_generation(0),
+		m_next(0),
+		m_remaining(0),
+		m_running(false),
+		m_task(NULL)
+	{
+		return;
+	}
+
+	_craft_perlin_pool::~_craft_perlin_pool(void)
+	{
+		stop();
+	}
+
+	void 
+	_craft_perlin_pool::execute(void)
+	{
+		uint32_t index;
+		void *context;
+		craft_perlin_task task;
+		std::exception_ptr error;
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		// tasks are claimed under the lock, so a worker waking late never sees half of a new batch
+		while(m_next < m_count) {
+			index = m_next++;
+			task = m_task;
+			context = m_context;
+			lock.unlock();
+
+			try {
+				task(context, index);
+			} catch(...) {
+				error = std::current_exception();
+			}
+
+			lock.lock();
+
+			if(error && !m_error) {
+				m_error = error;
+			}
+
+			error = std::exception_ptr();
+
+			if(!--m_remaining) {
+				m_condition_done.notify_all();
+			}
+		}
+	}
+
+	void 
+	_craft_perlin_pool::run(
+		__in craft_perlin_task task,
+		__in void *context,
+		__in uint32_t count
+		)
+	{
+		std::exception_ptr error;
+		std::lock_guard<std::mutex> lock_run(m_run_lock);
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_context = context;
+			m_count = count;
+			m_error = std::exception_ptr();
+			m_next = 0;
+			m_remaining = count;
+			m_task = task;
+			++m_generation;
+		}
+
+		// the caller takes tasks alongside the workers, so a pool without workers still completes
+		m_condition.notify_all();
+		execute();
+
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+
+			while(m_remaining) {
+				m_condition_done.wait(lock);
+			}
+
+			error = m_error;
+			m_error = std::exception_ptr();
+			m_context = NULL;
+			m_count = 0;
+			m_task = NULL;
+		}
+
+		if(error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	void 
+	_craft_perlin_pool::start(
+		__in uint32_t threads
+		)
+	{
+		uint32_t iter = 0;
+
+		stop();
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_running = true;
+		}
+
+		for(; iter < threads; ++iter) {
+			m_worker.push_back(std::thread(&_craft_perlin_pool::work, this));
+		}
+	}
+
+	void 
+	_craft_perlin_pool::stop(void)
+	{
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_running = false;
+		}
+
+		m_condition.notify_all();
+
+		for(std::vector<std::thread>::iterator iter = m_worker.begin(); iter != m_worker.end(); ++iter) {
+			iter->join();
+		}
+
+		m_worker.clear();
+	}
+
+	uint32_t 
+	_craft_perlin_pool::threads(void) const
+	{
+		return m_worker.size();
+	}
+
+	std::string 
+	_craft_perlin_pool::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_PERLIN_POOL_HEADER << " (THREADS. " << m_worker.size();
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_perlin_pool *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+
+	void 
+	_craft_perlin_pool::work(void)
+	{
+		uint64_t generation;
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		generation = m_generation;
+
+		for(;;) {
+
+			while(m_running && (generation == m_generation)) {
+				m_condition.wait(lock);
+			}
+
+			if(!m_running) {
+				break;
+			}
+
+			generation = m_generation;
+			lock.unlock();
+			execute();
+			lock.lock();
+		}
+	}
+
 	_craft_perlin_2d *_craft_perlin_2d::m_instance = NULL;
 
 	_craft_perlin_2d::_craft_perlin_2d(void) :
@@ -72,272 +416,1355 @@ namespace CRAFT {
 		__in uint32_t octaves,
 		__in double amplitude,
 		__in double persistence,
-		__in_opt bool bicubic
+		__in_opt bool bicubic,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
 		)
 	{
-		uint32_t iter_x, iter_y;
-		std::vector<double> result;
-		double amplitude_total = 0.0;
-		std::vector<std::vector<double>> noise;
-		std::vector<double>::iterator iter_result;
-		std::vector<std::vector<double>>::reverse_iterator iter_noise;
-
-		if(!m_initialized) {
-			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
-		}
-
-		if(position.x < offset.x) {
-			dimension.x = std::abs(offset.x - position.x);
-		} else {
-			dimension.x = std::abs(position.x - offset.x);
-		}
+		return generate(dimension, position, offset, octaves, amplitude, persistence, 
+			bicubic ? CRAFT_PERLIN_COSINE : CRAFT_PERLIN_LINEAR, mode, threads);
+	}
 
-		if(position.y < offset.y) {
-			dimension.y = std::abs(offset.y - position.y);
-		} else {
-			dimension.y = std::abs(position.y - offset.y);
-		}
+	std::vector<double> 
+	_craft_perlin_2d::generate(
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+		glm::ivec2 origin;
+		double scale = 1.0;
+		std::vector<double> result;
+		craft_perlin_workspace workspace;
 
+		generate_region(dimension, origin, position, offset, interpolation, mode);
 		result.resize(dimension.x * dimension.y, 0.0);
-		generate_noise(noise, dimension, position, octaves, bicubic);
+		generate_noise(result.data(), workspace, &scale, 1, CRAFT_PERLIN_PLANAR, dimension, origin, 0, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
 
-		if(!noise.empty()) {
-
-			for(iter_noise = noise.rbegin(); iter_noise != noise.rend(); 
-					++iter_noise) {
-				amplitude *= persistence;
-				amplitude_total += amplitude;
+		return result;
+	}
 
-				for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+	void 
+	_craft_perlin_2d::generate(
+		__out double *output,
+		__in size_t length,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+		glm::ivec2 origin;
+		double scale = 1.0;
 
-					for(iter_y = 0; iter_y < dimension.y; ++iter_y) {
-						result.at(SCALAR_INDEX_2D(iter_x, iter_y, dimension.x))
-							+= std::abs((iter_noise->at(SCALAR_INDEX_2D(iter_x, iter_y, dimension.x)) 
-							* amplitude));
-					}
-				}
-			}
+		generate_region(dimension, origin, position, offset, interpolation, mode);
 
-			for(iter_result = result.begin(); iter_result != result.end(); 
-					++iter_result) {
-				*iter_result /= amplitude_total;
-			}
+		if(length < ((size_t) dimension.x * dimension.y)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, (size_t) dimension.x * dimension.y);
 		}
 
-		return result;
+		generate_noise(output, workspace, &scale, 1, CRAFT_PERLIN_PLANAR, dimension, origin, 0, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
 	}
 
 	void 
-	_craft_perlin_2d::generate_noise(
-		__out std::vector<std::vector<double>> &noise,
-		__in const glm::uvec2 &dimension,
+	_craft_perlin_2d::generate(
+		__out float *output,
+		__in size_t length,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
 		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
 		__in uint32_t octaves,
-		__in_opt bool bicubic
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
 		)
 	{
-		craft_random *inst = NULL;
-		std::vector<double> rough, smooth;
-		double alpha_x, alpha_y, blend_bottom, blend_top, frequency;
-		uint32_t iter_oct = 0, iter_x, iter_y, period, sample_x0, sample_x1, sample_y0, sample_y1;
+		glm::ivec2 origin;
+		double scale = 1.0;
 
-		if(!m_initialized) {
-			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		generate_region(dimension, origin, position, offset, interpolation, mode);
+
+		if(length < ((size_t) dimension.x * dimension.y)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, (size_t) dimension.x * dimension.y);
 		}
 
-		noise.clear();
-		inst = craft_random::acquire();
-		rough.resize(dimension.x * dimension.y, 0.0);
+		generate_noise(output, workspace, &scale, 1, CRAFT_PERLIN_PLANAR, dimension, origin, 0, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
+	}
 
-		
+	void 
+	_craft_perlin_2d::generate(
+		__out uint8_t *output,
+		__in size_t length,
+		__in double scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+		glm::ivec2 origin;
 
-		for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+		generate_region(dimension, origin, position, offset, interpolation, mode);
 
-			for(iter_y = 0; iter_y < dimension.y; ++iter_y) {
-				rough.at(SCALAR_INDEX_2D(iter_x, iter_y, dimension.x)) = inst->generate_float();
-			}
+		if(length < ((size_t) dimension.x * dimension.y)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, (size_t) dimension.x * dimension.y);
 		}
 
-		for(; iter_oct < octaves; ++iter_oct) {
-			smooth.resize(dimension.x * dimension.y, 0.0);
-			period = (1 << iter_oct);
-			frequency = (1.0 / period);
-
-			for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
-				sample_x0 = (iter_x / period) * period;
-				sample_x1 = (sample_x0 + period) % dimension.x;
-				alpha_x = (iter_x - sample_x0) * frequency;
-
-				for(iter_y = 0; iter_y < dimension.y; ++iter_y) {
-					sample_y0 = (iter_y / period) * period;
-					sample_y1 = (sample_y0 + period) % dimension.y;
-					alpha_y = (iter_y - sample_y0) * frequency;
-					blend_top = interpolate_noise({rough.at(SCALAR_INDEX_2D(sample_x0, sample_y0, dimension.x)),
-						rough.at(SCALAR_INDEX_2D(sample_x1, sample_y0, dimension.x)), alpha_x}, bicubic);
-					blend_bottom = interpolate_noise({rough.at(SCALAR_INDEX_2D(sample_x0, sample_y1, dimension.x)),
-						rough.at(SCALAR_INDEX_2D(sample_x1, sample_y1, dimension.x)), alpha_x}, bicubic);
-					smooth.at(SCALAR_INDEX_2D(iter_x, iter_y, dimension.x)) = interpolate_noise(
-						{blend_top, blend_bottom, alpha_y}, bicubic);
-				}
-			}
-
-			noise.push_back(smooth);
-			smooth.clear();
-		}
+		generate_noise(output, workspace, &scale, 1, CRAFT_PERLIN_PLANAR, dimension, origin, 0, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
 	}
 
 	void 
-	_craft_perlin_2d::initialize(void)
+	_craft_perlin_2d::generate(
+		__out uint16_t *output,
+		__in size_t length,
+		__in double scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
 	{
+		glm::ivec2 origin;
 
-		if(m_initialized) {
-			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_INITIALIZED);
+		generate_region(dimension, origin, position, offset, interpolation, mode);
+
+		if(length < ((size_t) dimension.x * dimension.y)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, (size_t) dimension.x * dimension.y);
 		}
 
-		m_initialized = true;
+		generate_noise(output, workspace, &scale, 1, CRAFT_PERLIN_PLANAR, dimension, origin, 0, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
 	}
 
-	double 
-	_craft_perlin_2d::interpolate_noise(
-		__in const glm::vec3 &value,
-		__in_opt bool bicubic
+	void 
+	_craft_perlin_2d::generate(
+		__out float *output,
+		__in size_t length,
+		__in const std::vector<double> &scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_layout layout,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
 		)
 	{
-		double part, result;
+		glm::ivec2 origin;
 
-		if(!m_initialized) {
-			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
-		}
+		generate_region(dimension, origin, position, offset, interpolation, mode);
 
-		if(bicubic) {
-			part = (1.0 - std::cos(value.z * M_PI)) * 0.5;
-			result = value.x * (1.0 - part) + value.y * part;
-		} else {
-			result = value.x * (1.0 - value.z) + value.z * value.y;
+		if(scale.empty()) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_CHANNELS,
+				"%lu", scale.size());
 		}
 
-		return result;
-	}
+		if(layout > CRAFT_PERLIN_LAYOUT_MAX) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LAYOUT,
+				"0x%x", layout);
+		}
 
-	bool 
-	_craft_perlin_2d::is_allocated(void)
-	{
-		return (craft_perlin_2d::m_instance != NULL);
-	}
+		if(length < ((size_t) dimension.x * dimension.y * scale.size())) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, 
+				(size_t) dimension.x * dimension.y * scale.size());
+		}
 
-	bool 
-	_craft_perlin_2d::is_initialized(void)
-	{
-		return m_initialized;
+		generate_noise(output, workspace, scale.data(), scale.size(), layout, dimension, origin, 0, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
 	}
 
 	void 
-	_craft_perlin_2d::to_file(
-		__in const std::string &path,
-		__in const std::vector<double> &noise,
-		__in const glm::uvec2 &dimension,
-		__in_opt bool colorize
+	_craft_perlin_2d::generate(
+		__out uint8_t *output,
+		__in size_t length,
+		__in const std::vector<double> &scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_layout layout,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
 		)
 	{
-		double value;
-		std::string output;
-		std::stringstream stream;
-		uint32_t iter_x, iter_y = 0;
+		glm::ivec2 origin;
 
-		output = path + ".pbm";
+		generate_region(dimension, origin, position, offset, interpolation, mode);
 
-		std::ofstream file(output.c_str(), std::ios::out);
-		if(!file) {
-			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_FILE_NOT_FOUND,
-				"%s", STRING_CHECK(output));
+		if(scale.empty()) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_CHANNELS,
+				"%lu", scale.size());
 		}
 
-		if(colorize) {
-			stream << "P3" << std::endl;
-		} else {
-			stream << "P2" << std::endl;
-		}	
-
-		stream << dimension.x << " " << dimension.y << std::endl;
+		if(layout > CRAFT_PERLIN_LAYOUT_MAX) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LAYOUT,
+				"0x%x", layout);
+		}
 
-		if(colorize) {
-			stream << PERLIN_SCALE_COLOR << std::endl;
-		} else {
-			stream << PERLIN_SCALE_GREYSCALE << std::endl;
+		if(length < ((size_t) dimension.x * dimension.y * scale.size())) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should contain at least %lu entries)", length, 
+				(size_t) dimension.x * dimension.y * scale.size());
 		}
 
-		for(; iter_y < dimension.y; ++iter_y) {
+		generate_noise(output, workspace, scale.data(), scale.size(), layout, dimension, origin, 0, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
+	}
+
+	template <class P> double 
+	_craft_perlin_2d::accumulate_band(
+		__out double *result,
+		__inout craft_perlin_band &band,
+		__in const glm::uvec2 &dimension,
+		__in uint32_t level,
+		__in const glm::ivec2 &base,
+		__in uint32_t row_begin,
+		__in uint32_t row_end,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in craft_perlin_mode mode,
+		__in uint32_t seed,
+		__in const double *rough
+		)
+	{
+		const double *column_fade;
+		const uint32_t *column_cell;
+		glm::ivec2 lattice_origin, lattice_span;
+		double amplitude_skipped = 0.0, amplitude_total = 0.0, value;
+		const uint32_t width = NOISE_LEVEL_LENGTH(dimension.x, level);
+		uint32_t cell_x, cell_y, iter_oct = octaves, iter_x, iter_y, lattice_height, lattice_width, line_cell;
+
+		std::fill(result, result + SCALAR_INDEX_2D(0, row_end - row_begin, width), 0.0);
+
+		while(iter_oct-- > 0) {
+			amplitude *= persistence;
+			amplitude_total += amplitude;
+
+			// a level samples every 2^level pixels, so finer octaves fall between samples and only 
+			// contribute their mean
+			if(iter_oct < level) {
+				amplitude_skipped += (amplitude * NOISE_MEAN);
+				continue;
+			}
 
-			for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+			if(!iter_oct) {
 
-				if(iter_x > 0) {
-					stream << " ";
-				}
+				// the finest octave samples its lattice at every pixel, so no table is built
+				for(iter_y = row_begin; iter_y < row_end; ++iter_y) {
 
-				value = noise.at(SCALAR_INDEX_2D(iter_x, iter_y, dimension.x));
-
-				if(colorize) {
-
-					/**
-					 * Height-map gradient
-					 * ------------------
-					 * 0		{0, 0, 125}
-					 * 0.25		{0, 0, 255}
-					 * 0.4		{0, 125, 255}
-					 * 0.475	{225, 230, 75}
-					 * 0.485	{32, 160, 0}
-					 * 0.75		{220, 220, 0}
-					 * 0.85		{130, 130, 130}
-					 * 1		{255, 255, 255}
-					 */
-
-					if(value < 0.25) {
-						stream << "0 0 " << (uint32_t) (((255.0 - 125.0) * (value / 0.25)) + 125.0);
-					} else if(value < 0.4) {
-						stream << "0 " << (uint32_t) (125.0 * ((value - 0.25) / 0.15)) << " 255";
-					} else if(value < 0.475) {
-						stream << (uint32_t) (225.0 * ((value - 0.4) / 0.0625)) <<  " " 
-							<< (uint32_t) (((230.0 - 125.0) * ((value - 0.4) / 0.0625)) + 125.0) << " "
-							<< (uint32_t) (255.0 - ((255.0 - 75.0) * ((value - 0.4) / 0.0625)));
-					} else if(value < 0.485) {
-						stream << (uint32_t) (225.0 - ((225.0 - 32.0) * ((value - 0.475) / 0.01))) << " "
-							<< (uint32_t) (230.0 - ((230.0 - 160.0) * ((value - 0.475) / 0.01))) << " "
-							<< (uint32_t) (75.0 - (75.0 * ((value - 0.475) / 0.01)));
-					} else if(value < 0.75) {
-						stream << (uint32_t) (((220.0 - 32.0) * ((value - 0.485) / 0.265)) + 32.0) << " "
-							<< (uint32_t) (((220.0 - 160.0) * ((value - 0.485) / 0.265)) + 160.0) << " 0";
-					} else if(value < 0.85) {
-						stream << (uint32_t) (220.0 - ((220.0 - 130.0) * ((value - 0.75) / 0.1))) << " "
-							<< (uint32_t) (220.0 - ((220.0 - 130.0) * ((value - 0.75) / 0.1))) << " "
-							<< (uint32_t) (130.0 * ((value - 0.75) / 0.15));
-					} else {
-						stream << (uint32_t) (((255.0 - 130.0) * ((value - 0.85) / 0.15)) + 130.0) << " "
-							<< (uint32_t) (((255.0 - 130.0) * ((value - 0.85) / 0.15)) + 130.0) << " "
-							<< (uint32_t) (((255.0 - 130.0) * ((value - 0.85) / 0.15)) + 130.0);
+					for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+
+						if(mode == CRAFT_PERLIN_HASHED) {
+							value = (float) hash_noise(seed, base.x + (int32_t) iter_x, 
+								base.y + (int32_t) iter_y);
+						} else {
+							value = (float) rough[SCALAR_INDEX_2D(iter_y, iter_x, dimension.y)];
+						}
+
+						result[SCALAR_INDEX_2D(iter_x, iter_y - row_begin, dimension.x)] 
+							+= std::abs(value * amplitude);
+					}
+				}
+
+				break;
+			}
+
+			lattice_origin.x = (base.x & ~((1 << iter_oct) - 1));
+			lattice_origin.y = ((base.y + (int32_t) (row_begin << level)) & ~((1 << iter_oct) - 1));
+			lattice_width = (((base.x + (int32_t) ((width - 1) << level) - lattice_origin.x) >> iter_oct) + 2);
+			lattice_height = (((base.y + (int32_t) ((row_end - 1) << level) - lattice_origin.y) >> iter_oct) 
+				+ 2);
+			band.lattice.resize(lattice_width * lattice_height);
+
+			for(cell_y = 0; cell_y < lattice_height; ++cell_y) {
+
+				for(cell_x = 0; cell_x < lattice_width; ++cell_x) {
+
+					if(mode == CRAFT_PERLIN_HASHED) {
+						value = hash_noise(seed, lattice_origin.x + (int32_t) (cell_x << iter_oct), 
+							lattice_origin.y + (int32_t) (cell_y << iter_oct));
+					} else {
+						value = rough[SCALAR_INDEX_2D((lattice_origin.y + (cell_y << iter_oct)) % dimension.y, 
+							(lattice_origin.x + (cell_x << iter_oct)) % dimension.x, dimension.y)];
+					}
+
+					band.lattice[SCALAR_INDEX_2D(cell_x, cell_y, lattice_width)] = (float) value;
+				}
+			}
+
+			column_cell = &band.column_cell[SCALAR_INDEX_2D(0, iter_oct, width)];
+			column_fade = &band.column_fade[SCALAR_INDEX_2D(0, iter_oct, width)];
+			line_cell = UINT32_MAX;
+
+			for(iter_y = row_begin; iter_y < row_end; ++iter_y) {
+				lattice_span.y = (base.y + (int32_t) (iter_y << level) - lattice_origin.y);
+				cell_y = (lattice_span.y >> iter_oct);
+
+				if(line_cell != cell_y) {
+
+					if((line_cell != UINT32_MAX) && ((line_cell + 1) == cell_y)) {
+						band.line_top.swap(band.line_bottom);
+					} else {
+						blend_noise<P>(band.line_top, &band.lattice[SCALAR_INDEX_2D(0, cell_y, lattice_width)],
+							column_cell, column_fade);
+					}
+
+					blend_noise<P>(band.line_bottom, &band.lattice[SCALAR_INDEX_2D(0, cell_y + 1, 
+						lattice_width)], column_cell, column_fade);
+					line_cell = cell_y;
+				}
+
+				accumulate_noise<P>(&result[SCALAR_INDEX_2D(0, iter_y - row_begin, width)], 
+					&band.line_top[0], &band.line_bottom[0], P::fade(std::ldexp((double) (lattice_span.y 
+					& ((1 << iter_oct) - 1)), -(int32_t) iter_oct)), amplitude, width);
+			}
+		}
+
+		if(amplitude_skipped > 0.0) {
+
+			for(iter_x = 0; iter_x < SCALAR_INDEX_2D(0, row_end - row_begin, width); ++iter_x) {
+				result[iter_x] += amplitude_skipped;
+			}
+		}
+
+		return (octaves ? amplitude_total : 1.0);
+	}
+
+	template <class P> void 
+	_craft_perlin_2d::accumulate_noise(
+		__inout double *result,
+		__in const double *top,
+		__in const double *bottom,
+		__in double weight,
+		__in double amplitude,
+		__in uint32_t count
+		)
+	{
+		uint32_t iter = 0;
+		double value, weight_inverse = (1.0 - weight);
+
+#if defined(__AVX__)
+		__m256d vec_amplitude = _mm256_set1_pd(amplitude), vec_mask = _mm256_castsi256_pd(
+			_mm256_set1_epi64x(NOISE_ABS_MASK)), vec_value, vec_weight = _mm256_set1_pd(weight), 
+			vec_weight_inverse = _mm256_set1_pd(weight_inverse);
+
+		for(; (iter + 4) <= count; iter += 4) {
+			vec_value = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(top + iter), vec_weight_inverse),
+				P::blend(_mm256_loadu_pd(bottom + iter), vec_weight));
+			vec_value = _mm256_and_pd(_mm256_mul_pd(vec_value, vec_amplitude), vec_mask);
+			_mm256_storeu_pd(result + iter, _mm256_add_pd(_mm256_loadu_pd(result + iter), vec_value));
+		}
+#elif defined(__SSE2__)
+		__m128d vec_amplitude = _mm_set1_pd(amplitude), vec_mask = _mm_castsi128_pd(
+			_mm_set1_epi64x(NOISE_ABS_MASK)), vec_value, vec_weight = _mm_set1_pd(weight), 
+			vec_weight_inverse = _mm_set1_pd(weight_inverse);
+
+		for(; (iter + 2) <= count; iter += 2) {
+			vec_value = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(top + iter), vec_weight_inverse),
+				P::blend(_mm_loadu_pd(bottom + iter), vec_weight));
+			vec_value = _mm_and_pd(_mm_mul_pd(vec_value, vec_amplitude), vec_mask);
+			_mm_storeu_pd(result + iter, _mm_add_pd(_mm_loadu_pd(result + iter), vec_value));
+		}
+#endif // __AVX__ || __SSE2__
+
+		for(; iter < count; ++iter) {
+			value = ((top[iter] * weight_inverse) + P::blend(bottom[iter], weight));
+			result[iter] += std::abs(value * amplitude);
+		}
+	}
+
+	template <class P> void 
+	_craft_perlin_2d::blend_noise(
+		__out std::vector<double> &line,
+		__in const double *lattice,
+		__in const uint32_t *cell,
+		__in const double *fade
+		)
+	{
+		uint32_t iter = 0;
+		double weight;
+
+		for(; iter < line.size(); ++iter) {
+			weight = fade[iter];
+			line[iter] = P::line((lattice[cell[iter]] * (1.0 - weight)) + P::blend(lattice[cell[iter] + 1], 
+				weight));
+		}
+	}
+
+	template <typename T, class P> void 
+	_craft_perlin_2d::generate_band(
+		__out T *output,
+		__inout craft_perlin_band &band,
+		__in const double *scale,
+		__in uint32_t channels,
+		__in craft_perlin_layout layout,
+		__in const glm::uvec2 &dimension,
+		__in uint32_t level,
+		__in const glm::ivec2 &base,
+		__in uint32_t row_begin,
+		__in uint32_t row_end,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in craft_perlin_mode mode,
+		__in uint32_t seed,
+		__in const double *rough
+		)
+	{
+		double total;
+		int32_t lattice_span;
+		const uint32_t width = NOISE_LEVEL_LENGTH(dimension.x, level);
+		size_t plane, plane_source = ((size_t) dimension.x * dimension.y), stride;
+		uint32_t iter_channel = 0, iter_oct = std::max(level, (uint32_t) 1), iter_x, strip, strip_begin, 
+			strip_end;
+
+		// the scratch tables only grow, so a warm band reuses its storage
+		band.column_cell.resize(octaves * width);
+		band.column_fade.resize(octaves * width);
+		band.line_bottom.resize(width);
+		band.line_top.resize(width);
+
+		if(layout == CRAFT_PERLIN_INTERLEAVED) {
+			plane = 1;
+			stride = channels;
+		} else {
+			plane = ((size_t) width * NOISE_LEVEL_LENGTH(dimension.y, level));
+			stride = 1;
+		}
+
+		// column cells and fades depend only on the octave, so every strip and channel shares them
+		for(; iter_oct < octaves; ++iter_oct) {
+
+			for(iter_x = 0; iter_x < width; ++iter_x) {
+				lattice_span = (base.x + (int32_t) (iter_x << level) - (base.x & ~((1 << iter_oct) - 1)));
+				band.column_cell[SCALAR_INDEX_2D(iter_x, iter_oct, width)] = (lattice_span >> iter_oct);
+				band.column_fade[SCALAR_INDEX_2D(iter_x, iter_oct, width)] = P::fade(std::ldexp(
+					(double) (lattice_span & ((1 << iter_oct) - 1)), -(int32_t) iter_oct));
+			}
+		}
+
+		// octaves are summed a strip at a time, so the double accumulator stays cache resident 
+		// and only the finished values reach the output
+		strip = std::max(NOISE_STRIP_LENGTH / std::max(width, (uint32_t) 1), (uint32_t) 1);
+
+		// each channel is its own field, seeded apart or drawn from its own source plane, and sweeps 
+		// the whole band before the next, so only one source plane is read at a time
+		for(iter_channel = 0; iter_channel < channels; ++iter_channel) {
+
+			for(strip_begin = row_begin; strip_begin < row_end; strip_begin = strip_end) {
+				strip_end = std::min(strip_begin + strip, row_end);
+				band.strip.resize(SCALAR_INDEX_2D(0, strip_end - strip_begin, width));
+				total = accumulate_band<P>(band.strip.data(), band, dimension, level, base, strip_begin, 
+					strip_end, octaves, amplitude, persistence, mode, 
+					craft_random::derive_seed(seed, iter_channel), 
+					rough ? (rough + (iter_channel * plane_source)) : NULL);
+				store_noise(output + (iter_channel * plane) + (SCALAR_INDEX_2D(0, strip_begin - row_begin, 
+					width) * stride), band.strip.data(), band.strip.size(), total, scale[iter_channel], 
+					stride);
+			}
+		}
+	}
+
+	std::vector<double> 
+	_craft_perlin_2d::generate_level(
+		__out glm::uvec2 &dimension,
+		__in uint32_t level,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+		glm::ivec2 origin;
+		double scale = 1.0;
+		glm::uvec2 region;
+		std::vector<double> result;
+		craft_perlin_workspace workspace;
+
+		generate_region(region, origin, position, offset, interpolation, mode);
+
+		if(level >= level_count(region)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LEVEL,
+				"%u (should be less than %u)", level, level_count(region));
+		}
+
+		dimension = glm::uvec2{NOISE_LEVEL_LENGTH(region.x, level), NOISE_LEVEL_LENGTH(region.y, level)};
+		result.resize(dimension.x * dimension.y, 0.0);
+		generate_noise(result.data(), workspace, &scale, 1, CRAFT_PERLIN_PLANAR, region, origin, level, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
+
+		return result;
+	}
+
+	template <typename T> void 
+	_craft_perlin_2d::generate_noise(
+		__out T *output,
+		__inout craft_perlin_workspace &workspace,
+		__in const double *scale,
+		__in uint32_t channels,
+		__in craft_perlin_layout layout,
+		__in const glm::uvec2 &dimension,
+		__in const glm::ivec2 &origin,
+		__in uint32_t level,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads,
+		__in_opt bool redraw
+		)
+	{
+		glm::ivec2 base;
+		uint32_t seed = 0;
+		craft_random *inst = NULL;
+		const double *rough = NULL;
+		_craft_perlin_band_task<T> task;
+		const glm::uvec2 sample = {NOISE_LEVEL_LENGTH(dimension.x, level), 
+			NOISE_LEVEL_LENGTH(dimension.y, level)};
+		decltype(&craft_perlin_2d::generate_band<T, craft_perlin_linear>) generate = NULL;
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		// the interpolation is resolved once per call, so each band runs a kernel specialized for it
+		switch(interpolation) {
+			case CRAFT_PERLIN_COSINE:
+				generate = craft_perlin_2d::generate_band<T, craft_perlin_cosine>;
+				break;
+			case CRAFT_PERLIN_HERMITE:
+				generate = craft_perlin_2d::generate_band<T, craft_perlin_hermite>;
+				break;
+			case CRAFT_PERLIN_QUINTIC:
+				generate = craft_perlin_2d::generate_band<T, craft_perlin_quintic>;
+				break;
+			default:
+				generate = craft_perlin_2d::generate_band<T, craft_perlin_linear>;
+				break;
+		}
+
+		inst = craft_random::acquire();
+
+		if(mode == CRAFT_PERLIN_HASHED) {
+			seed = inst->seed();
+			base = origin;
+		} else {
+			base = glm::ivec2{0, 0};
+
+			// the source planes are drawn column by column, so they are kept column-major, and 
+			// each channel takes the next plane from the same draw, which every level then shares
+			if(redraw) {
+				workspace.rough.resize(dimension.x * dimension.y * channels);
+				inst->generate_float(workspace.rough.data(), workspace.rough.size());
+			}
+
+			rough = workspace.rough.data();
+		}
+
+		if(!threads) {
+			threads = std::thread::hardware_concurrency();
+		}
+
+		threads = std::max(std::min(threads, sample.y), (uint32_t) 1);
+
+		if(workspace.band.size() < threads) {
+			workspace.band.resize(threads);
+		}
+
+		if(threads == 1) {
+			generate(output, workspace.band.front(), scale, channels, layout, dimension, level, base, 0, 
+				sample.y, octaves, amplitude, persistence, mode, seed, rough);
+		} else {
+
+			// the workers persist across calls, so a warm call starts no threads
+			if(!m_pool.threads() && (std::thread::hardware_concurrency() > 1)) {
+				m_pool.start(std::thread::hardware_concurrency() - 1);
+			}
+
+			task = {generate, output, workspace.band.data(), scale, channels, layout, dimension, level, base, 
+				sample, (sample.y + threads - 1) / threads, (layout == CRAFT_PERLIN_INTERLEAVED) ? channels : 1, 
+				octaves, amplitude, persistence, mode, seed, rough};
+
+			// each band builds the lattice rows it touches, so bands share nothing but the source plane
+			m_pool.run(craft_perlin_2d::generate_task<T>, &task, (sample.y + task.rows - 1) / task.rows);
+		}
+	}
+
+	std::vector<craft_perlin_level> 
+	_craft_perlin_2d::generate_pyramid(
+		__in uint32_t levels,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+		glm::ivec2 origin;
+		double scale = 1.0;
+		glm::uvec2 region;
+		uint32_t iter = 0;
+		craft_perlin_workspace workspace;
+		std::vector<craft_perlin_level> result;
+
+		generate_region(region, origin, position, offset, interpolation, mode);
+
+		if(!levels || (levels > level_count(region))) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LEVEL,
+				"%u (should be between 1 and %u)", levels, level_count(region));
+		}
+
+		result.resize(levels);
+
+		// each level evaluates only the octaves at or above its spacing, so level k costs about 1/4^k 
+		// of the first, and only the first level draws the tiled source plane
+		for(; iter < levels; ++iter) {
+			result[iter].dimension = glm::uvec2{NOISE_LEVEL_LENGTH(region.x, iter), 
+				NOISE_LEVEL_LENGTH(region.y, iter)};
+			result[iter].noise.resize(result[iter].dimension.x * result[iter].dimension.y, 0.0);
+			generate_noise(result[iter].noise.data(), workspace, &scale, 1, CRAFT_PERLIN_PLANAR, region, 
+				origin, iter, octaves, amplitude, persistence, interpolation, mode, threads, !iter);
+		}
+
+		return result;
+	}
+
+	void 
+	_craft_perlin_2d::generate_region(
+		__out glm::uvec2 &dimension,
+		__out glm::ivec2 &origin,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(interpolation > CRAFT_PERLIN_INTERPOLATION_MAX) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_INTERPOLATION,
+				"0x%x", interpolation);
+		}
+
+		if(mode > CRAFT_PERLIN_MODE_MAX) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_MODE,
+				"0x%x", mode);
+		}
+
+		if(position.x < offset.x) {
+			dimension.x = std::abs(offset.x - position.x);
+		} else {
+			dimension.x = std::abs(position.x - offset.x);
+		}
+
+		if(position.y < offset.y) {
+			dimension.y = std::abs(offset.y - position.y);
+		} else {
+			dimension.y = std::abs(position.y - offset.y);
+		}
+
+		origin.x = std::floor(std::min(position.x, offset.x));
+		origin.y = std::floor(std::min(position.y, offset.y));
+	}
+
+	template <typename T> void 
+	_craft_perlin_2d::generate_task(
+		__in void *context,
+		__in uint32_t index
+		)
+	{
+		const _craft_perlin_band_task<T> *task = (const _craft_perlin_band_task<T> *) context;
+
+		task->generate(task->output + (SCALAR_INDEX_2D(0, index * task->rows, task->sample.x) * task->stride), 
+			task->band[index], task->scale, task->channels, task->layout, task->dimension, task->level, 
+			task->base, index * task->rows, std::min((index + 1) * task->rows, task->sample.y), task->octaves, 
+			task->amplitude, task->persistence, task->mode, task->seed, task->rough);
+	}
+
+	void 
+	_craft_perlin_2d::gradient_color(
+		__in double value,
+		__out uint8_t *color
+		)
+	{
+
+		/**
+		 * Height-map gradient
+		 * ------------------
+		 * 0		{0, 0, 125}
+		 * 0.25		{0, 0, 255}
+		 * 0.4		{0, 125, 255}
+		 * 0.475	{225, 230, 75}
+		 * 0.485	{32, 160, 0}
+		 * 0.75		{220, 220, 0}
+		 * 0.85		{130, 130, 130}
+		 * 1		{255, 255, 255}
+		 */
+
+		if(value < 0.25) {
+			color[0] = 0;
+			color[1] = 0;
+			color[2] = (uint32_t) (((255.0 - 125.0) * (value / 0.25)) + 125.0);
+		} else if(value < 0.4) {
+			color[0] = 0;
+			color[1] = (uint32_t) (125.0 * ((value - 0.25) / 0.15));
+			color[2] = 255;
+		} else if(value < 0.475) {
+			color[0] = (uint32_t) std::min(225.0 * ((value - 0.4) / 0.0625), (double) PERLIN_SCALE_COLOR);
+			color[1] = (uint32_t) (((230.0 - 125.0) * ((value - 0.4) / 0.0625)) + 125.0);
+			color[2] = (uint32_t) (255.0 - ((255.0 - 75.0) * ((value - 0.4) / 0.0625)));
+		} else if(value < 0.485) {
+			color[0] = (uint32_t) (225.0 - ((225.0 - 32.0) * ((value - 0.475) / 0.01)));
+			color[1] = (uint32_t) (230.0 - ((230.0 - 160.0) * ((value - 0.475) / 0.01)));
+			color[2] = (uint32_t) (75.0 - (75.0 * ((value - 0.475) / 0.01)));
+		} else if(value < 0.75) {
+			color[0] = (uint32_t) (((220.0 - 32.0) * ((value - 0.485) / 0.265)) + 32.0);
+			color[1] = (uint32_t) (((220.0 - 160.0) * ((value - 0.485) / 0.265)) + 160.0);
+			color[2] = 0;
+		} else if(value < 0.85) {
+			color[0] = (uint32_t) (220.0 - ((220.0 - 130.0) * ((value - 0.75) / 0.1)));
+			color[1] = (uint32_t) (220.0 - ((220.0 - 130.0) * ((value - 0.75) / 0.1)));
+			color[2] = (uint32_t) (130.0 * ((value - 0.75) / 0.15));
+		} else {
+			color[0] = (uint32_t) (((255.0 - 130.0) * ((value - 0.85) / 0.15)) + 130.0);
+			color[1] = color[0];
+			color[2] = color[0];
+		}
+	}
+
+	double 
+	_craft_perlin_2d::hash_noise(
+		__in uint32_t seed,
+		__in int32_t x,
+		__in int32_t y
+		)
+	{
+		uint64_t result;
+
+		result = ((((uint64_t) (uint32_t) x) << 32) | (uint32_t) y);
+		result ^= (seed * HASH_NOISE_STEP);
+		result = (result ^ (result >> 30)) * HASH_NOISE_MIX_0;
+		result = (result ^ (result >> 27)) * HASH_NOISE_MIX_1;
+		result ^= (result >> 31);
+
+		return (result >> 11) * HASH_NOISE_SCALE;
+	}
+
+	void 
+	_craft_perlin_2d::initialize(void)
+	{
+
+		if(m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_INITIALIZED);
+		}
+
+		m_initialized = true;
+	}
+
+	bool 
+	_craft_perlin_2d::is_allocated(void)
+	{
+		return (craft_perlin_2d::m_instance != NULL);
+	}
+
+	bool 
+	_craft_perlin_2d::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	uint32_t 
+	_craft_perlin_2d::level_count(
+		__in const glm::uvec2 &dimension
+		)
+	{
+		uint32_t result = 0;
+
+		// the last level is a single sample along the longer side
+		while((result < NOISE_LEVEL_MAX) && ((1U << result) < std::max(dimension.x, dimension.y))) {
+			++result;
+		}
+
+		return (result + 1);
+	}
+
+	template <typename T> void 
+	_craft_perlin_2d::store_noise(
+		__out T *output,
+		__in const double *result,
+		__in uint32_t count,
+		__in double total,
+		__in double scale,
+		__in_opt uint32_t stride
+		)
+	{
+		double value;
+		uint32_t iter = 0;
+
+		// integer outputs are clamped to their range, while floating outputs take the value as is, 
+		// and a unit stride is kept apart so the common planar store still vectorizes
+		if(stride == 1) {
+
+			for(; iter < count; ++iter) {
+				value = ((result[iter] / total) * scale);
+				output[iter] = (std::numeric_limits<T>::is_integer ? std::min(std::max(0.0, value), 
+					(double) std::numeric_limits<T>::max()) : value);
+			}
+		} else {
+
+			for(; iter < count; ++iter) {
+				value = ((result[iter] / total) * scale);
+				output[iter * stride] = (std::numeric_limits<T>::is_integer ? std::min(std::max(0.0, value), 
+					(double) std::numeric_limits<T>::max()) : value);
+			}
+		}
+	}
+
+	void 
+	_craft_perlin_2d::to_file(
+		__in const std::string &path,
+		__in const std::vector<double> &noise,
+		__in const glm::uvec2 &dimension,
+		__in_opt bool colorize,
+		__in_opt bool wide
+		)
+	{
+		double value;
+		const double *input;
+		std::vector<uint8_t> row;
+		std::vector<uint16_t> row_wide;
+		uint32_t iter_x, iter_y = 0;
+		craft_image_format format = CRAFT_IMAGE_GREYSCALE;
+		uint16_t maximum = PERLIN_SCALE_GREYSCALE;
+
+		if(noise.size() < ((size_t) dimension.x * dimension.y)) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LENGTH,
+				"%lu (should be at least %lu)", noise.size(), 
+				(size_t) dimension.x * dimension.y);
+		}
+
+		if(colorize) {
+			format = CRAFT_IMAGE_COLOR;
+			maximum = PERLIN_SCALE_COLOR;
+		} else if(wide) {
+			maximum = PERLIN_SCALE_WIDE;
+		}
+
+		craft_image_writer file(path + craft_image_writer::extension(format), dimension, 
+			format, maximum);
+
+		if(colorize) {
+			row.resize(dimension.x * 3);
+		} else if(wide) {
+			row_wide.resize(dimension.x);
+		} else {
+			row.resize(dimension.x);
+		}
+
+		for(; iter_y < dimension.y; ++iter_y) {
+			input = &noise[SCALAR_INDEX_2D(0, iter_y, dimension.x)];
+
+			if(colorize) {
+
+				for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+					gradient_color(input[iter_x], &row[iter_x * 3]);
+				}
+
+				file.write(&row[0]);
+			} else if(wide) {
+
+				for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+					value = std::min(std::max(0.0, input[iter_x]), 1.0);
+					row_wide[iter_x] = (uint16_t) ((PERLIN_SCALE_WIDE * value) + 0.5);
+				}
+
+				file.write(&row_wide[0]);
+			} else {
+
+				for(iter_x = 0; iter_x < dimension.x; ++iter_x) {
+					value = std::min(std::max(0.0, input[iter_x]), 1.0);
+					row[iter_x] = (uint8_t) (PERLIN_SCALE_GREYSCALE * value);
+				}
+
+				file.write(&row[0]);
+			}
+		}
+
+		file.close();
+	}
+
+	void 
+	_craft_perlin_2d::to_file(
+		__in const std::string &path,
+		__in const std::vector<craft_perlin_level> &pyramid,
+		__in uint32_t level,
+		__in_opt bool colorize,
+		__in_opt bool wide
+		)
+	{
+
+		if(level >= pyramid.size()) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_LEVEL,
+				"%u (should be less than %lu)", level, pyramid.size());
+		}
+
+		to_file(path, pyramid[level].noise, pyramid[level].dimension, colorize, wide);
+	}
+
+	std::string 
+	_craft_perlin_2d::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_PERLIN_2D_HEADER << " (" << (m_initialized ? "INITIALIZED" : "UNINITIALIZED");
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_perlin_2d *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+
+	void 
+	_craft_perlin_2d::uninitialize(void)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_initialized = false;
+	}
+
+	_craft_random_stream::_craft_random_stream(
+		__in_opt uint32_t seed,
+		__in_opt uint32_t id,
+		__in_opt uint64_t counter
+		) :
+			m_counter(counter),
+			m_id(id),
+			m_seed(seed)
+	{
+		generate_block();
+	}
+
+	_craft_random_stream::_craft_random_stream(
+		__in const _craft_random_stream &other
+		) :
+			m_counter(other.m_counter),
+			m_id(other.m_id),
+			m_seed(other.m_seed)
+	{
+		std::copy(other.m_block, other.m_block + PHILOX_WORDS, m_block);
+	}
+
+	_craft_random_stream::~_craft_random_stream(void)
+	{
+		return;
+	}
+
+	_craft_random_stream &
+	_craft_random_stream::operator=(
+		__in const _craft_random_stream &other
+		)
+	{
+
+		if(this != &other) {
+			std::copy(other.m_block, other.m_block + PHILOX_WORDS, m_block);
+			m_counter = other.m_counter;
+			m_id = other.m_id;
+			m_seed = other.m_seed;
+		}
+
+		return *this;
+	}
+
+	uint64_t 
+	_craft_random_stream::counter(void)
+	{
+		return m_counter;
+	}
+
+	uint32_t 
+	_craft_random_stream::generate_bounded(
+		__in uint64_t range
+		)
+	{
+		uint64_t product;
+		uint32_t threshold;
+
+		if(range > UINT32_MAX) {
+			return generate_word();
+		}
+
+		// Lemire's multiply-shift; the modulo is only taken when a draw lands in the biased zone
+		product = ((uint64_t) generate_word() * range);
+		if((uint32_t) product < range) {
+			threshold = ((uint32_t) -range % (uint32_t) range);
+
+			while((uint32_t) product < threshold) {
+				product = ((uint64_t) generate_word() * range);
+			}
+		}
+
+		return (product >> 32);
+	}
+
+	void 
+	_craft_random_stream::generate_bounded(
+		__out uint32_t *output,
+		__in size_t count,
+		__in uint64_t range
+		)
+	{
+		uint64_t product;
+		uint32_t threshold = 0;
+		size_t iter = 0, next = count;
+
+		if(range <= UINT32_MAX) {
+			threshold = ((uint32_t) -range % (uint32_t) range);
+		}
+
+		// words are drawn into the output ahead of the draws and bounded in place, and whatever rejections 
+		// leave short is drawn once they run out, so the stream advances exactly as it would one at a time
+		while(iter < count) {
+
+			if(next == count) {
+				generate_words(&output[iter], count - iter);
+				next = iter;
+			}
+
+			product = ((uint64_t) output[next++] * range);
+			if((uint32_t) product >= threshold) {
+				output[iter++] = (product >> 32);
+			}
+		}
+	}
+
+	void 
+	_craft_random_stream::generate_block(void)
+	{
+		uint64_t product_0, product_1;
+		uint32_t iter = 0, key[] = {m_seed, m_id}, word[PHILOX_WORDS];
+
+		word[0] = (uint32_t) (m_counter >> 2);
+		word[1] = (uint32_t) (m_counter >> 34);
+		word[2] = 0;
+		word[3] = 0;
+
+		for(; iter < PHILOX_ROUNDS; ++iter) {
+			product_0 = ((uint64_t) PHILOX_MUL_0 * word[0]);
+			product_1 = ((uint64_t) PHILOX_MUL_1 * word[2]);
+			word[0] = ((uint32_t) (product_1 >> 32) ^ word[1] ^ key[0]);
+			word[1] = (uint32_t) product_1;
+			word[2] = ((uint32_t) (product_0 >> 32) ^ word[3] ^ key[1]);
+			word[3] = (uint32_t) product_0;
+			key[0] += PHILOX_WEYL_0;
+			key[1] += PHILOX_WEYL_1;
+		}
+
+		std::copy(word, word + PHILOX_WORDS, m_block);
+	}
+
+	double 
+	_craft_random_stream::generate_float(
+		__in_opt double min,
+		__in_opt double max
+		)
+	{
+		uint64_t value;
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%f - %f} (min >= max)", min, max);
+		}
+
+		value = ((uint64_t) (generate_word() >> 5) << 26);
+		value |= (generate_word() >> 6);
+
+		return (min + ((max - min) * (value * STREAM_FLOAT_SCALE)));
+	}
+
+	void 
+	_craft_random_stream::generate_float(
+		__out double *output,
+		__in size_t count,
+		__in_opt double min,
+		__in_opt double max
+		)
+	{
+		uint64_t value;
+		size_t iter = 0;
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%f - %f} (min >= max)", min, max);
+		}
+
+		for(; iter < count; ++iter) {
+			value = ((uint64_t) (generate_word() >> 5) << 26);
+			value |= (generate_word() >> 6);
+			output[iter] = (min + ((max - min) * (value * STREAM_FLOAT_SCALE)));
+		}
+	}
+
+	int32_t 
+	_craft_random_stream::generate_signed(
+		__in_opt int32_t min,
+		__in_opt int32_t max
+		)
+	{
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%i - %i} (min >= max)", min, max);
+		}
+
+		return (int32_t) ((uint32_t) min + generate_bounded(((int64_t) max - min) + 1));
+	}
+
+	void 
+	_craft_random_stream::generate_signed(
+		__out int32_t *output,
+		__in size_t count,
+		__in_opt int32_t min,
+		__in_opt int32_t max
+		)
+	{
+		size_t iter = 0;
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%i - %i} (min >= max)", min, max);
+		}
+
+		generate_bounded((uint32_t *) output, count, ((int64_t) max - min) + 1);
+
+		for(; iter < count; ++iter) {
+			output[iter] = (int32_t) ((uint32_t) min + (uint32_t) output[iter]);
+		}
+	}
+
+	uint32_t 
+	_craft_random_stream::generate_unsigned(
+		__in_opt uint32_t min,
+		__in_opt uint32_t max
+		)
+	{
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%u - %u} (min >= max)", min, max);
+		}
+
+		return (min + generate_bounded(((uint64_t) max - min) + 1));
+	}
+
+	void 
+	_craft_random_stream::generate_unsigned(
+		__out uint32_t *output,
+		__in size_t count,
+		__in_opt uint32_t min,
+		__in_opt uint32_t max
+		)
+	{
+		size_t iter = 0;
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%u - %u} (min >= max)", min, max);
+		}
+
+		generate_bounded(output, count, ((uint64_t) max - min) + 1);
+
+		for(; iter < count; ++iter) {
+			output[iter] += min;
+		}
+	}
+
+	uint32_t 
+	_craft_random_stream::generate_word(void)
+	{
+		uint32_t result = m_block[m_counter & (PHILOX_WORDS - 1)];
+
+		if(!(++m_counter & (PHILOX_WORDS - 1))) {
+			generate_block();
+		}
+
+		return result;
+	}
+
+	void 
+	_craft_random_stream::generate_words(
+		__out uint32_t *output,
+		__in size_t count
+		)
+	{
+		size_t iter = 0;
+#if defined(__AVX2__)
+		uint64_t block;
+		uint32_t batch, lane, round, word;
+		uint64_t result[PHILOX_WORDS][PHILOX_LANES];
+		__m256i vec_key[2], vec_product[2], vec_word[PHILOX_BATCH][PHILOX_WORDS];
+
+		for(; (iter < count) && (m_counter & (PHILOX_WORDS - 1)); ++iter) {
+			output[iter] = generate_word();
+		}
+
+		// blocks depend on their counter alone, so from a block boundary on they are run four to a register, 
+		// where only the low half of each lane carries a word and the multiply ignores the rest
+		if((iter + (PHILOX_BATCH * PHILOX_LANES * PHILOX_WORDS)) <= count) {
+
+			for(; (iter + (PHILOX_BATCH * PHILOX_LANES * PHILOX_WORDS)) <= count; 
+					iter += (PHILOX_BATCH * PHILOX_LANES * PHILOX_WORDS), 
+					m_counter += (PHILOX_BATCH * PHILOX_LANES * PHILOX_WORDS)) {
+				block = (m_counter / PHILOX_WORDS);
+				vec_key[0] = _mm256_set1_epi64x(m_seed);
+				vec_key[1] = _mm256_set1_epi64x(m_id);
+
+				for(batch = 0; batch < PHILOX_BATCH; ++batch) {
+					vec_word[batch][0] = _mm256_add_epi64(_mm256_set1_epi64x(block + (batch * PHILOX_LANES)), 
+						_mm256_setr_epi64x(0, 1, 2, 3));
+					vec_word[batch][1] = _mm256_srli_epi64(vec_word[batch][0], 32);
+					vec_word[batch][2] = _mm256_setzero_si256();
+					vec_word[batch][3] = _mm256_setzero_si256();
+				}
+
+				for(round = 0; round < PHILOX_ROUNDS; ++round) {
+
+					for(batch = 0; batch < PHILOX_BATCH; ++batch) {
+						vec_product[0] = _mm256_mul_epu32(vec_word[batch][0], _mm256_set1_epi64x(PHILOX_MUL_0));
+						vec_product[1] = _mm256_mul_epu32(vec_word[batch][2], _mm256_set1_epi64x(PHILOX_MUL_1));
+						vec_word[batch][0] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(vec_product[1], 32), 
+							vec_word[batch][1]), vec_key[0]);
+						vec_word[batch][1] = vec_product[1];
+						vec_word[batch][2] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(vec_product[0], 32), 
+							vec_word[batch][3]), vec_key[1]);
+						vec_word[batch][3] = vec_product[0];
+					}
+
+					vec_key[0] = _mm256_add_epi64(vec_key[0], _mm256_set1_epi64x(PHILOX_WEYL_0));
+					vec_key[1] = _mm256_add_epi64(vec_key[1], _mm256_set1_epi64x(PHILOX_WEYL_1));
+				}
+
+				for(batch = 0; batch < PHILOX_BATCH; ++batch) {
+
+					for(word = 0; word < PHILOX_WORDS; ++word) {
+						_mm256_storeu_si256((__m256i *) result[word], vec_word[batch][word]);
+					}
+
+					for(lane = 0; lane < PHILOX_LANES; ++lane) {
+
+						for(word = 0; word < PHILOX_WORDS; ++word) {
+							output[iter + (((batch * PHILOX_LANES) + lane) * PHILOX_WORDS) + word] = 
+								(uint32_t) result[word][lane];
+						}
 					}
-				} else {
-					stream << (uint32_t) (PERLIN_SCALE_GREYSCALE * value);
 				}
 			}
 
-			stream << std::endl;
+			generate_block();
 		}
+#endif // __AVX2__
+
+		for(; iter < count; ++iter) {
+			output[iter] = generate_word();
+		}
+	}
+
+	uint32_t 
+	_craft_random_stream::id(void)
+	{
+		return m_id;
+	}
+
+	uint32_t 
+	_craft_random_stream::seed(void)
+	{
+		return m_seed;
+	}
 
-		file.write(stream.str().c_str(), stream.str().size());
-		file.close();
+	void 
+	_craft_random_stream::seek(
+		__in uint64_t counter
+		)
+	{
+		m_counter = counter;
+		generate_block();
 	}
 
 	std::string 
-	_craft_perlin_2d::to_string(
+	_craft_random_stream::to_string(
 		__in_opt bool verbose
 		)
 	{
 		std::stringstream result;
 
-		result << CRAFT_PERLIN_2D_HEADER << " (" << (m_initialized ? "INITIALIZED" : "UNINITIALIZED");
+		result << CRAFT_RANDOM_STREAM_HEADER << " (SEED. 0x" << SCALAR_AS_HEX(uint32_t, m_seed)
+			<< ", ID. 0x" << SCALAR_AS_HEX(uint32_t, m_id) << ", COUNT. " << m_counter;
 
 		if(verbose) {
-			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_perlin_2d *, this);
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_random_stream *, this);
 		}
 
 		result << ")";
@@ -345,22 +1772,13 @@ namespace CRAFT {
 		return result.str();
 	}
 
-	void 
-	_craft_perlin_2d::uninitialize(void)
-	{
-
-		if(!m_initialized) {
-			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
-		}
-
-		m_initialized = false;
-	}
-
 	_craft_random *_craft_random::m_instance = NULL;
 
 	_craft_random::_craft_random(void) :
 		m_initialized(false),
 		m_instance_perlin_2d(craft_perlin_2d::acquire()),
+		m_instance_simplex_2d(craft_simplex_2d::acquire()),
+		m_instance_simplex_3d(craft_simplex_3d::acquire()),
 		m_seed(0)
 	{
 		std::atexit(craft_random::_delete);
@@ -399,6 +1817,23 @@ namespace CRAFT {
 		return craft_random::m_instance;
 	}
 
+	uint32_t 
+	_craft_random::derive_seed(
+		__in uint32_t seed,
+		__in uint32_t index
+		)
+	{
+		uint64_t result;
+
+		// sub-seeds are mixed rather than offset, so index k of one seed never equals index k - 1 of the next
+		result = (seed ^ (index * HASH_NOISE_STEP));
+		result = (result ^ (result >> 30)) * HASH_NOISE_MIX_0;
+		result = (result ^ (result >> 27)) * HASH_NOISE_MIX_1;
+		result ^= (result >> 31);
+
+		return (uint32_t) (result >> 32);
+	}
+
 	double 
 	_craft_random::generate_float(
 		__in_opt double min,
@@ -418,6 +1853,80 @@ namespace CRAFT {
 		return std::uniform_real_distribution<double>(min, max)(m_engine);
 	}
 
+	void 
+	_craft_random::generate_float(
+		__out double *output,
+		__in size_t count,
+		__in_opt double min,
+		__in_opt double max
+		)
+	{
+		size_t iter = 0;
+		std::uniform_real_distribution<double> distribution;
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%f - %f} (min >= max)", min, max);
+		}
+
+		// the distribution is stateless, so a batch matches the same number of single draws
+		distribution.param(std::uniform_real_distribution<double>::param_type(min, max));
+
+		for(; iter < count; ++iter) {
+			output[iter] = distribution(m_engine);
+		}
+	}
+
+	uint32_t 
+	_craft_random::generate_bounded(
+		__in uint64_t range
+		)
+	{
+		uint64_t product;
+		uint32_t threshold;
+
+		if(range > UINT32_MAX) {
+			return m_engine();
+		}
+
+		product = ((uint64_t) m_engine() * range);
+		if((uint32_t) product < range) {
+			threshold = ((uint32_t) -range % (uint32_t) range);
+
+			while((uint32_t) product < threshold) {
+				product = ((uint64_t) m_engine() * range);
+			}
+		}
+
+		return (product >> 32);
+	}
+
+	std::vector<double> 
+	_craft_random::generate_perlin_2d(
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt bool bicubic,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		return m_instance_perlin_2d->generate(dimension, position, offset, octaves, 
+			amplitude, persistence, bicubic, mode, threads);
+	}
+
 	std::vector<double> 
 	_craft_random::generate_perlin_2d(
 		__out glm::uvec2 &dimension,
@@ -426,7 +1935,9 @@ namespace CRAFT {
 		__in uint32_t octaves,
 		__in double amplitude,
 		__in double persistence,
-		__in_opt bool bicubic
+		__in craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
 		)
 	{
 
@@ -435,7 +1946,208 @@ namespace CRAFT {
 		}
 
 		return m_instance_perlin_2d->generate(dimension, position, offset, octaves, 
-			amplitude, persistence, bicubic);
+			amplitude, persistence, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out double *output,
+		__in size_t length,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, workspace, dimension, position, offset, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out float *output,
+		__in size_t length,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, workspace, dimension, position, offset, 
+			octaves, amplitude, persistence, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out uint8_t *output,
+		__in size_t length,
+		__in double scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, scale, workspace, dimension, position, 
+			offset, octaves, amplitude, persistence, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out uint16_t *output,
+		__in size_t length,
+		__in double scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, scale, workspace, dimension, position, 
+			offset, octaves, amplitude, persistence, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out float *output,
+		__in size_t length,
+		__in const std::vector<double> &scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_layout layout,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, scale, workspace, dimension, position, offset, 
+			octaves, amplitude, persistence, layout, interpolation, mode, threads);
+	}
+
+	void 
+	_craft_random::generate_perlin_2d(
+		__out uint8_t *output,
+		__in size_t length,
+		__in const std::vector<double> &scale,
+		__inout craft_perlin_workspace &workspace,
+		__out glm::uvec2 &dimension,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_layout layout,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_instance_perlin_2d->generate(output, length, scale, workspace, dimension, position, offset, 
+			octaves, amplitude, persistence, layout, interpolation, mode, threads);
+	}
+
+	std::vector<double> 
+	_craft_random::generate_perlin_2d_level(
+		__out glm::uvec2 &dimension,
+		__in uint32_t level,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		return m_instance_perlin_2d->generate_level(dimension, level, position, offset, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
+	}
+
+	std::vector<craft_perlin_level> 
+	_craft_random::generate_perlin_2d_pyramid(
+		__in uint32_t levels,
+		__in const glm::vec2 &position,
+		__in const glm::vec2 &offset,
+		__in uint32_t octaves,
+		__in double amplitude,
+		__in double persistence,
+		__in_opt craft_perlin_interpolation interpolation,
+		__in_opt craft_perlin_mode mode,
+		__in_opt uint32_t threads
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		return m_instance_perlin_2d->generate_pyramid(levels, position, offset, octaves, 
+			amplitude, persistence, interpolation, mode, threads);
 	}
 
 	int32_t 
@@ -457,6 +2169,33 @@ namespace CRAFT {
 		return std::uniform_int_distribution<int32_t>(min, max)(m_engine);
 	}
 
+	void 
+	_craft_random::generate_signed(
+		__out int32_t *output,
+		__in size_t count,
+		__in_opt int32_t min,
+		__in_opt int32_t max
+		)
+	{
+		size_t iter = 0;
+		uint64_t range;
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%i - %i} (min >= max)", min, max);
+		}
+
+		range = (((int64_t) max - min) + 1);
+
+		for(; iter < count; ++iter) {
+			output[iter] = (int32_t) ((uint32_t) min + generate_bounded(range));
+		}
+	}
+
 	uint32_t 
 	_craft_random::generate_unsigned(
 		__in_opt uint32_t min,
@@ -476,6 +2215,33 @@ namespace CRAFT {
 		return std::uniform_int_distribution<uint32_t>(min, max)(m_engine);
 	}
 
+	void 
+	_craft_random::generate_unsigned(
+		__out uint32_t *output,
+		__in size_t count,
+		__in_opt uint32_t min,
+		__in_opt uint32_t max
+		)
+	{
+		size_t iter = 0;
+		uint64_t range;
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(min >= max) {
+			THROW_CRAFT_RANDOM_EXCEPTION_FORMAT(CRAFT_RANDOM_EXCEPTION_INVALID_RANGE,
+				"{%u - %u} (min >= max)", min, max);
+		}
+
+		range = (((uint64_t) max - min) + 1);
+
+		for(; iter < count; ++iter) {
+			output[iter] = (min + generate_bounded(range));
+		}
+	}
+
 	void 
 	_craft_random::initialize(
 		__in uint32_t seed
@@ -490,6 +2256,8 @@ namespace CRAFT {
 		m_seed = seed;
 		reset();
 		m_instance_perlin_2d->initialize();
+		m_instance_simplex_2d->initialize();
+		m_instance_simplex_3d->initialize();
 	}
 
 	bool 
@@ -526,6 +2294,19 @@ namespace CRAFT {
 		return m_seed;
 	}
 
+	craft_random_stream 
+	_craft_random::stream(
+		__in uint32_t id
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
+		}
+
+		return craft_random_stream(m_seed, id);
+	}
+
 	std::string 
 	_craft_random::to_string(
 		__in_opt bool verbose
@@ -552,6 +2333,8 @@ namespace CRAFT {
 			THROW_CRAFT_RANDOM_EXCEPTION(CRAFT_RANDOM_EXCEPTION_UNINITIALIZED);
 		}
 
+		m_instance_simplex_3d->uninitialize();
+		m_instance_simplex_2d->uninitialize();
 		m_instance_perlin_2d->uninitialize();
 		m_seed = 0;
 		reset();
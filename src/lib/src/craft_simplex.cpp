@@ -0,0 +1,730 @@
+/**
+ * libcraft
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * libcraft is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcraft is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif // __AVX2__
+#include "../include/craft.h"
+#include "../include/craft_simplex_type.h"
+
+namespace CRAFT {
+
+	#define SIMPLEX_2D_RADIUS 0.5f
+	#define SIMPLEX_2D_SCALE 70.f
+	#define SIMPLEX_2D_SKEW 0.36602540378443865f
+	#define SIMPLEX_2D_UNSKEW 0.21132486540518713f
+
+	#define SIMPLEX_3D_RADIUS 0.6f
+	#define SIMPLEX_3D_SCALE 32.f
+	#define SIMPLEX_3D_SKEW (1.f / 3.f)
+	#define SIMPLEX_3D_UNSKEW (1.f / 6.f)
+
+	#define SIMPLEX_BLOCK 256
+	#define SIMPLEX_LACUNARITY 2.f
+
+	#define SIMPLEX_HASH_MIX 0x27d4eb2dU
+	#define SIMPLEX_PRIME_X 501125321U
+	#define SIMPLEX_PRIME_Y 1136930381U
+	#define SIMPLEX_PRIME_Z 1720413743U
+
+	#define SIMPLEX_HASH_2D(_X_, _Y_, _SEED_) \
+		(((((uint32_t) (_X_)) * SIMPLEX_PRIME_X) ^ (((uint32_t) (_Y_)) * SIMPLEX_PRIME_Y) \
+		^ (_SEED_)) * SIMPLEX_HASH_MIX)
+	#define SIMPLEX_HASH_3D(_X_, _Y_, _Z_, _SEED_) \
+		(((((uint32_t) (_X_)) * SIMPLEX_PRIME_X) ^ (((uint32_t) (_Y_)) * SIMPLEX_PRIME_Y) \
+		^ (((uint32_t) (_Z_)) * SIMPLEX_PRIME_Z) ^ (_SEED_)) * SIMPLEX_HASH_MIX)
+
+	// gradients are picked by the top bits of the corner hash, 3 bits in 2D and 4 bits in 3D
+	static const float SIMPLEX_2D_GRADIENT_X[] = {
+		1.f, -1.f, 1.f, -1.f, 1.f, -1.f, 0.f, 0.f,
+		};
+
+	static const float SIMPLEX_2D_GRADIENT_Y[] = {
+		1.f, 1.f, -1.f, -1.f, 0.f, 0.f, 1.f, -1.f,
+		};
+
+	static const float SIMPLEX_3D_GRADIENT_X[] = {
+		1.f, -1.f, 1.f, -1.f, 1.f, -1.f, 1.f, -1.f,
+		0.f, 0.f, 0.f, 0.f, 1.f, 0.f, -1.f, 0.f,
+		};
+
+	static const float SIMPLEX_3D_GRADIENT_Y[] = {
+		1.f, 1.f, -1.f, -1.f, 0.f, 0.f, 0.f, 0.f,
+		1.f, -1.f, 1.f, -1.f, 1.f, -1.f, 1.f, -1.f,
+		};
+
+	static const float SIMPLEX_3D_GRADIENT_Z[] = {
+		0.f, 0.f, 0.f, 0.f, 1.f, 1.f, -1.f, -1.f,
+		1.f, 1.f, -1.f, -1.f, 0.f, 1.f, 0.f, -1.f,
+		};
+
+	_craft_simplex_2d *_craft_simplex_2d::m_instance = NULL;
+
+	_craft_simplex_2d::_craft_simplex_2d(void) :
+		m_initialized(false)
+	{
+		std::atexit(craft_simplex_2d::_delete);
+	}
+
+	_craft_simplex_2d::~_craft_simplex_2d(void)
+	{
+
+		if(m_initialized) {
+			uninitialize();
+		}
+	}
+
+	void 
+	_craft_simplex_2d::_delete(void)
+	{
+
+		if(craft_simplex_2d::m_instance) {
+			delete craft_simplex_2d::m_instance;
+			craft_simplex_2d::m_instance = NULL;
+		}
+	}
+
+	void 
+	_craft_simplex_2d::accumulate_noise(
+		__inout float *output,
+		__in const float *x,
+		__in const float *y,
+		__in size_t count,
+		__in uint32_t seed,
+		__in float frequency,
+		__in float amplitude
+		)
+	{
+		size_t iter = 0;
+
+#if defined(__AVX2__)
+		uint32_t iter_corner;
+		__m256i vec_cell_x, vec_cell_y, vec_hash[3], vec_index, vec_offset;
+		__m256 vec_base_x, vec_base_y, vec_corner_x[3], vec_corner_y[3], vec_mask, vec_result, vec_skew,
+			vec_weight, vec_x, vec_y;
+		const __m256 vec_amplitude = _mm256_set1_ps(amplitude), vec_frequency = _mm256_set1_ps(frequency), 
+			vec_gradient_x = _mm256_loadu_ps(SIMPLEX_2D_GRADIENT_X), 
+			vec_gradient_y = _mm256_loadu_ps(SIMPLEX_2D_GRADIENT_Y), vec_one = _mm256_set1_ps(1.f), 
+			vec_radius = _mm256_set1_ps(SIMPLEX_2D_RADIUS), vec_scale = _mm256_set1_ps(SIMPLEX_2D_SCALE), 
+			vec_unskew = _mm256_set1_ps(SIMPLEX_2D_UNSKEW), 
+			vec_unskew_double = _mm256_set1_ps(2.f * SIMPLEX_2D_UNSKEW), vec_zero = _mm256_setzero_ps();
+		const __m256i vec_mix = _mm256_set1_epi32(SIMPLEX_HASH_MIX), vec_one_int = _mm256_set1_epi32(1), 
+			vec_prime_x = _mm256_set1_epi32(SIMPLEX_PRIME_X), vec_prime_y = _mm256_set1_epi32(SIMPLEX_PRIME_Y),
+			vec_seed = _mm256_set1_epi32(seed);
+
+		for(; (iter + 8) <= count; iter += 8) {
+			vec_x = _mm256_mul_ps(_mm256_loadu_ps(x + iter), vec_frequency);
+			vec_y = _mm256_mul_ps(_mm256_loadu_ps(y + iter), vec_frequency);
+			vec_skew = _mm256_mul_ps(_mm256_add_ps(vec_x, vec_y), _mm256_set1_ps(SIMPLEX_2D_SKEW));
+			vec_base_x = _mm256_floor_ps(_mm256_add_ps(vec_x, vec_skew));
+			vec_base_y = _mm256_floor_ps(_mm256_add_ps(vec_y, vec_skew));
+			vec_skew = _mm256_mul_ps(_mm256_add_ps(vec_base_x, vec_base_y), vec_unskew);
+			vec_corner_x[0] = _mm256_sub_ps(vec_x, _mm256_sub_ps(vec_base_x, vec_skew));
+			vec_corner_y[0] = _mm256_sub_ps(vec_y, _mm256_sub_ps(vec_base_y, vec_skew));
+
+			// the lower triangle steps along x first, the upper along y
+			vec_mask = _mm256_and_ps(_mm256_cmp_ps(vec_corner_x[0], vec_corner_y[0], _CMP_GT_OQ), vec_one);
+			vec_corner_x[1] = _mm256_add_ps(_mm256_sub_ps(vec_corner_x[0], vec_mask), vec_unskew);
+			vec_corner_y[1] = _mm256_add_ps(_mm256_sub_ps(vec_corner_y[0], _mm256_sub_ps(vec_one, vec_mask)), 
+				vec_unskew);
+			vec_corner_x[2] = _mm256_add_ps(_mm256_sub_ps(vec_corner_x[0], vec_one), vec_unskew_double);
+			vec_corner_y[2] = _mm256_add_ps(_mm256_sub_ps(vec_corner_y[0], vec_one), vec_unskew_double);
+
+			vec_cell_x = _mm256_cvttps_epi32(vec_base_x);
+			vec_cell_y = _mm256_cvttps_epi32(vec_base_y);
+			vec_offset = _mm256_cvttps_epi32(vec_mask);
+			vec_hash[0] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_mullo_epi32(vec_cell_x, 
+				vec_prime_x), _mm256_mullo_epi32(vec_cell_y, vec_prime_y)), vec_seed), vec_mix);
+			vec_hash[1] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_mullo_epi32(
+				_mm256_add_epi32(vec_cell_x, vec_offset), vec_prime_x), _mm256_mullo_epi32(_mm256_add_epi32(
+				vec_cell_y, _mm256_sub_epi32(vec_one_int, vec_offset)), vec_prime_y)), vec_seed), vec_mix);
+			vec_hash[2] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_mullo_epi32(
+				_mm256_add_epi32(vec_cell_x, vec_one_int), vec_prime_x), _mm256_mullo_epi32(_mm256_add_epi32(
+				vec_cell_y, vec_one_int), vec_prime_y)), vec_seed), vec_mix);
+			vec_result = vec_zero;
+
+			for(iter_corner = 0; iter_corner < 3; ++iter_corner) {
+				vec_weight = _mm256_sub_ps(_mm256_sub_ps(vec_radius, _mm256_mul_ps(vec_corner_x[iter_corner], 
+					vec_corner_x[iter_corner])), _mm256_mul_ps(vec_corner_y[iter_corner], vec_corner_y[iter_corner]));
+				vec_weight = _mm256_max_ps(vec_weight, vec_zero);
+				vec_weight = _mm256_mul_ps(vec_weight, vec_weight);
+				vec_index = _mm256_srli_epi32(vec_hash[iter_corner], 29);
+				vec_result = _mm256_add_ps(vec_result, _mm256_mul_ps(_mm256_mul_ps(vec_weight, vec_weight), 
+					_mm256_add_ps(_mm256_mul_ps(_mm256_permutevar8x32_ps(vec_gradient_x, vec_index), 
+					vec_corner_x[iter_corner]), _mm256_mul_ps(_mm256_permutevar8x32_ps(vec_gradient_y, vec_index), 
+					vec_corner_y[iter_corner]))));
+			}
+
+			_mm256_storeu_ps(output + iter, _mm256_add_ps(_mm256_loadu_ps(output + iter), 
+				_mm256_mul_ps(_mm256_mul_ps(vec_result, vec_scale), vec_amplitude)));
+		}
+#endif // __AVX2__
+
+		for(; iter < count; ++iter) {
+			output[iter] += (evaluate_noise(x[iter] * frequency, y[iter] * frequency, seed) * amplitude);
+		}
+	}
+
+	_craft_simplex_2d *
+	_craft_simplex_2d::acquire(void)
+	{
+
+		if(!craft_simplex_2d::m_instance) {
+
+			craft_simplex_2d::m_instance = new craft_simplex_2d;
+			if(!craft_simplex_2d::m_instance) {
+				THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_ALLOCATED);
+			}
+		}
+
+		return craft_simplex_2d::m_instance;
+	}
+
+	float 
+	_craft_simplex_2d::evaluate_noise(
+		__in float x,
+		__in float y,
+		__in uint32_t seed
+		)
+	{
+		uint32_t hash, iter = 0;
+		int32_t cell_x, cell_y, offset;
+		float base_x, base_y, corner_x[3], corner_y[3], result = 0.f, skew, weight;
+
+		skew = ((x + y) * SIMPLEX_2D_SKEW);
+		base_x = std::floor(x + skew);
+		base_y = std::floor(y + skew);
+		skew = ((base_x + base_y) * SIMPLEX_2D_UNSKEW);
+		corner_x[0] = (x - (base_x - skew));
+		corner_y[0] = (y - (base_y - skew));
+		offset = ((corner_x[0] > corner_y[0]) ? 1 : 0);
+		corner_x[1] = ((corner_x[0] - (float) offset) + SIMPLEX_2D_UNSKEW);
+		corner_y[1] = ((corner_y[0] - (float) (1 - offset)) + SIMPLEX_2D_UNSKEW);
+		corner_x[2] = ((corner_x[0] - 1.f) + (2.f * SIMPLEX_2D_UNSKEW));
+		corner_y[2] = ((corner_y[0] - 1.f) + (2.f * SIMPLEX_2D_UNSKEW));
+		cell_x = (int32_t) base_x;
+		cell_y = (int32_t) base_y;
+
+		for(; iter < 3; ++iter) {
+
+			switch(iter) {
+				case 0:
+					hash = SIMPLEX_HASH_2D(cell_x, cell_y, seed);
+					break;
+				case 1:
+					hash = SIMPLEX_HASH_2D(cell_x + offset, cell_y + (1 - offset), seed);
+					break;
+				default:
+					hash = SIMPLEX_HASH_2D(cell_x + 1, cell_y + 1, seed);
+					break;
+			}
+
+			weight = ((SIMPLEX_2D_RADIUS - (corner_x[iter] * corner_x[iter])) - (corner_y[iter] * corner_y[iter]));
+			weight = ((weight > 0.f) ? weight : 0.f);
+			weight *= weight;
+			hash >>= 29;
+			result += ((weight * weight) * ((SIMPLEX_2D_GRADIENT_X[hash] * corner_x[iter]) 
+				+ (SIMPLEX_2D_GRADIENT_Y[hash] * corner_y[iter])));
+		}
+
+		return (result * SIMPLEX_2D_SCALE);
+	}
+
+	void 
+	_craft_simplex_2d::generate(
+		__out float *output,
+		__in const float *x,
+		__in const float *y,
+		__in size_t count,
+		__in_opt uint32_t octaves,
+		__in_opt float frequency,
+		__in_opt float persistence
+		)
+	{
+		size_t iter = 0;
+		uint32_t iter_oct = 0, seed;
+		float amplitude = 1.f, amplitude_total = 0.f;
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(count && (!output || !x || !y)) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_INVALID_PARAMETER);
+		}
+
+		seed = craft_random::acquire()->seed();
+		std::fill(output, output + count, 0.f);
+
+		// each octave is seeded on its own, so the octaves do not share a lattice
+		for(; iter_oct < octaves; ++iter_oct) {
+			accumulate_noise(output, x, y, count, craft_random::derive_seed(seed, iter_oct), frequency, 
+				amplitude);
+			amplitude_total += amplitude;
+			amplitude *= persistence;
+			frequency *= SIMPLEX_LACUNARITY;
+		}
+
+		if(amplitude_total > 0.f) {
+
+			for(; iter < count; ++iter) {
+				output[iter] /= amplitude_total;
+			}
+		}
+	}
+
+	void 
+	_craft_simplex_2d::generate(
+		__out std::vector<float> &output,
+		__in const std::vector<glm::vec2> &point,
+		__in_opt uint32_t octaves,
+		__in_opt float frequency,
+		__in_opt float persistence
+		)
+	{
+		size_t begin = 0, count, iter;
+		float block_x[SIMPLEX_BLOCK], block_y[SIMPLEX_BLOCK];
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		output.resize(point.size());
+
+		// points are split into planar blocks on the stack, which the batch kernel reads directly
+		for(; begin < point.size(); begin += count) {
+			count = std::min(point.size() - begin, (size_t) SIMPLEX_BLOCK);
+
+			for(iter = 0; iter < count; ++iter) {
+				block_x[iter] = point[begin + iter].x;
+				block_y[iter] = point[begin + iter].y;
+			}
+
+			generate(&output[begin], block_x, block_y, count, octaves, frequency, persistence);
+		}
+	}
+
+	void 
+	_craft_simplex_2d::initialize(void)
+	{
+
+		if(m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_INITIALIZED);
+		}
+
+		m_initialized = true;
+	}
+
+	bool 
+	_craft_simplex_2d::is_allocated(void)
+	{
+		return (craft_simplex_2d::m_instance != NULL);
+	}
+
+	bool 
+	_craft_simplex_2d::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	std::string 
+	_craft_simplex_2d::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_SIMPLEX_2D_HEADER << " (" << (m_initialized ? "INITIALIZED" : "UNINITIALIZED");
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_simplex_2d *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+
+	void 
+	_craft_simplex_2d::uninitialize(void)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_initialized = false;
+	}
+
+	_craft_simplex_3d *_craft_simplex_3d::m_instance = NULL;
+
+	_craft_simplex_3d::_craft_simplex_3d(void) :
+		m_initialized(false)
+	{
+		std::atexit(craft_simplex_3d::_delete);
+	}
+
+	_craft_simplex_3d::~_craft_simplex_3d(void)
+	{
+
+		if(m_initialized) {
+			uninitialize();
+		}
+	}
+
+	void 
+	_craft_simplex_3d::_delete(void)
+	{
+
+		if(craft_simplex_3d::m_instance) {
+			delete craft_simplex_3d::m_instance;
+			craft_simplex_3d::m_instance = NULL;
+		}
+	}
+
+	void 
+	_craft_simplex_3d::accumulate_noise(
+		__inout float *output,
+		__in const float *x,
+		__in const float *y,
+		__in const float *z,
+		__in size_t count,
+		__in uint32_t seed,
+		__in float frequency,
+		__in float amplitude
+		)
+	{
+		size_t iter = 0;
+
+#if defined(__AVX2__)
+		uint32_t iter_corner;
+		__m256i vec_cell_x, vec_cell_y, vec_cell_z, vec_hash[4], vec_index, vec_offset_x[2], vec_offset_y[2], 
+			vec_offset_z[2];
+		__m256 vec_base_x, vec_base_y, vec_base_z, vec_corner_x[4], vec_corner_y[4], vec_corner_z[4], 
+			vec_gradient, vec_high, vec_mask_x[2], vec_mask_y[2], vec_mask_z[2], vec_result, vec_skew, 
+			vec_weight, vec_x, vec_y, vec_z;
+		const __m256 vec_amplitude = _mm256_set1_ps(amplitude), vec_frequency = _mm256_set1_ps(frequency), 
+			vec_gradient_x[] = {_mm256_loadu_ps(SIMPLEX_3D_GRADIENT_X), _mm256_loadu_ps(SIMPLEX_3D_GRADIENT_X + 8)}, 
+			vec_gradient_y[] = {_mm256_loadu_ps(SIMPLEX_3D_GRADIENT_Y), _mm256_loadu_ps(SIMPLEX_3D_GRADIENT_Y + 8)}, 
+			vec_gradient_z[] = {_mm256_loadu_ps(SIMPLEX_3D_GRADIENT_Z), _mm256_loadu_ps(SIMPLEX_3D_GRADIENT_Z + 8)}, 
+			vec_one = _mm256_set1_ps(1.f), vec_radius = _mm256_set1_ps(SIMPLEX_3D_RADIUS), 
+			vec_scale = _mm256_set1_ps(SIMPLEX_3D_SCALE), vec_unskew = _mm256_set1_ps(SIMPLEX_3D_UNSKEW), 
+			vec_unskew_double = _mm256_set1_ps(2.f * SIMPLEX_3D_UNSKEW), 
+			vec_unskew_triple = _mm256_set1_ps(3.f * SIMPLEX_3D_UNSKEW), vec_zero = _mm256_setzero_ps();
+		const __m256i vec_mix = _mm256_set1_epi32(SIMPLEX_HASH_MIX), vec_one_int = _mm256_set1_epi32(1), 
+			vec_prime_x = _mm256_set1_epi32(SIMPLEX_PRIME_X), vec_prime_y = _mm256_set1_epi32(SIMPLEX_PRIME_Y),
+			vec_prime_z = _mm256_set1_epi32(SIMPLEX_PRIME_Z), vec_seed = _mm256_set1_epi32(seed), 
+			vec_seven = _mm256_set1_epi32(7);
+
+		for(; (iter + 8) <= count; iter += 8) {
+			vec_x = _mm256_mul_ps(_mm256_loadu_ps(x + iter), vec_frequency);
+			vec_y = _mm256_mul_ps(_mm256_loadu_ps(y + iter), vec_frequency);
+			vec_z = _mm256_mul_ps(_mm256_loadu_ps(z + iter), vec_frequency);
+			vec_skew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(vec_x, vec_y), vec_z), 
+				_mm256_set1_ps(SIMPLEX_3D_SKEW));
+			vec_base_x = _mm256_floor_ps(_mm256_add_ps(vec_x, vec_skew));
+			vec_base_y = _mm256_floor_ps(_mm256_add_ps(vec_y, vec_skew));
+			vec_base_z = _mm256_floor_ps(_mm256_add_ps(vec_z, vec_skew));
+			vec_skew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(vec_base_x, vec_base_y), vec_base_z), vec_unskew);
+			vec_corner_x[0] = _mm256_sub_ps(vec_x, _mm256_sub_ps(vec_base_x, vec_skew));
+			vec_corner_y[0] = _mm256_sub_ps(vec_y, _mm256_sub_ps(vec_base_y, vec_skew));
+			vec_corner_z[0] = _mm256_sub_ps(vec_z, _mm256_sub_ps(vec_base_z, vec_skew));
+
+			// the two middle corners follow the axes in order of decreasing offset
+			vec_mask_x[0] = _mm256_and_ps(_mm256_cmp_ps(vec_corner_x[0], vec_corner_y[0], _CMP_GE_OQ), 
+				_mm256_cmp_ps(vec_corner_x[0], vec_corner_z[0], _CMP_GE_OQ));
+			vec_mask_y[0] = _mm256_and_ps(_mm256_cmp_ps(vec_corner_y[0], vec_corner_x[0], _CMP_GT_OQ), 
+				_mm256_cmp_ps(vec_corner_y[0], vec_corner_z[0], _CMP_GE_OQ));
+			vec_mask_z[0] = _mm256_and_ps(_mm256_cmp_ps(vec_corner_z[0], vec_corner_x[0], _CMP_GT_OQ), 
+				_mm256_cmp_ps(vec_corner_z[0], vec_corner_y[0], _CMP_GT_OQ));
+			vec_mask_x[1] = _mm256_or_ps(_mm256_cmp_ps(vec_corner_x[0], vec_corner_y[0], _CMP_GE_OQ), 
+				_mm256_cmp_ps(vec_corner_x[0], vec_corner_z[0], _CMP_GE_OQ));
+			vec_mask_y[1] = _mm256_or_ps(_mm256_cmp_ps(vec_corner_y[0], vec_corner_x[0], _CMP_GT_OQ), 
+				_mm256_cmp_ps(vec_corner_y[0], vec_corner_z[0], _CMP_GE_OQ));
+			vec_mask_z[1] = _mm256_or_ps(_mm256_cmp_ps(vec_corner_z[0], vec_corner_x[0], _CMP_GT_OQ), 
+				_mm256_cmp_ps(vec_corner_z[0], vec_corner_y[0], _CMP_GT_OQ));
+
+			for(iter_corner = 0; iter_corner < 2; ++iter_corner) {
+				vec_mask_x[iter_corner] = _mm256_and_ps(vec_mask_x[iter_corner], vec_one);
+				vec_mask_y[iter_corner] = _mm256_and_ps(vec_mask_y[iter_corner], vec_one);
+				vec_mask_z[iter_corner] = _mm256_and_ps(vec_mask_z[iter_corner], vec_one);
+				vec_offset_x[iter_corner] = _mm256_cvttps_epi32(vec_mask_x[iter_corner]);
+				vec_offset_y[iter_corner] = _mm256_cvttps_epi32(vec_mask_y[iter_corner]);
+				vec_offset_z[iter_corner] = _mm256_cvttps_epi32(vec_mask_z[iter_corner]);
+				vec_skew = (iter_corner ? vec_unskew_double : vec_unskew);
+				vec_corner_x[iter_corner + 1] = _mm256_add_ps(_mm256_sub_ps(vec_corner_x[0], 
+					vec_mask_x[iter_corner]), vec_skew);
+				vec_corner_y[iter_corner + 1] = _mm256_add_ps(_mm256_sub_ps(vec_corner_y[0], 
+					vec_mask_y[iter_corner]), vec_skew);
+				vec_corner_z[iter_corner + 1] = _mm256_add_ps(_mm256_sub_ps(vec_corner_z[0], 
+					vec_mask_z[iter_corner]), vec_skew);
+			}
+
+			vec_corner_x[3] = _mm256_add_ps(_mm256_sub_ps(vec_corner_x[0], vec_one), vec_unskew_triple);
+			vec_corner_y[3] = _mm256_add_ps(_mm256_sub_ps(vec_corner_y[0], vec_one), vec_unskew_triple);
+			vec_corner_z[3] = _mm256_add_ps(_mm256_sub_ps(vec_corner_z[0], vec_one), vec_unskew_triple);
+
+			vec_cell_x = _mm256_cvttps_epi32(vec_base_x);
+			vec_cell_y = _mm256_cvttps_epi32(vec_base_y);
+			vec_cell_z = _mm256_cvttps_epi32(vec_base_z);
+			vec_hash[0] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(
+				_mm256_mullo_epi32(vec_cell_x, vec_prime_x), _mm256_mullo_epi32(vec_cell_y, vec_prime_y)), 
+				_mm256_mullo_epi32(vec_cell_z, vec_prime_z)), vec_seed), vec_mix);
+
+			for(iter_corner = 0; iter_corner < 2; ++iter_corner) {
+				vec_hash[iter_corner + 1] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(
+					_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_x, vec_offset_x[iter_corner]), vec_prime_x), 
+					_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_y, vec_offset_y[iter_corner]), vec_prime_y)), 
+					_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_z, vec_offset_z[iter_corner]), vec_prime_z)), 
+					vec_seed), vec_mix);
+			}
+
+			vec_hash[3] = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(
+				_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_x, vec_one_int), vec_prime_x), 
+				_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_y, vec_one_int), vec_prime_y)), 
+				_mm256_mullo_epi32(_mm256_add_epi32(vec_cell_z, vec_one_int), vec_prime_z)), vec_seed), vec_mix);
+			vec_result = vec_zero;
+
+			for(iter_corner = 0; iter_corner < 4; ++iter_corner) {
+				vec_weight = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(vec_radius, _mm256_mul_ps(
+					vec_corner_x[iter_corner], vec_corner_x[iter_corner])), _mm256_mul_ps(vec_corner_y[iter_corner], 
+					vec_corner_y[iter_corner])), _mm256_mul_ps(vec_corner_z[iter_corner], vec_corner_z[iter_corner]));
+				vec_weight = _mm256_max_ps(vec_weight, vec_zero);
+				vec_weight = _mm256_mul_ps(vec_weight, vec_weight);
+
+				// the 16 entry tables are split in two, with the high half picked by bit 3 of the index
+				vec_index = _mm256_srli_epi32(vec_hash[iter_corner], 28);
+				vec_high = _mm256_castsi256_ps(_mm256_cmpgt_epi32(vec_index, vec_seven));
+				vec_gradient = _mm256_mul_ps(_mm256_blendv_ps(_mm256_permutevar8x32_ps(vec_gradient_x[0], vec_index), 
+					_mm256_permutevar8x32_ps(vec_gradient_x[1], vec_index), vec_high), vec_corner_x[iter_corner]);
+				vec_gradient = _mm256_add_ps(vec_gradient, _mm256_mul_ps(_mm256_blendv_ps(_mm256_permutevar8x32_ps(
+					vec_gradient_y[0], vec_index), _mm256_permutevar8x32_ps(vec_gradient_y[1], vec_index), vec_high), 
+					vec_corner_y[iter_corner]));
+				vec_gradient = _mm256_add_ps(vec_gradient, _mm256_mul_ps(_mm256_blendv_ps(_mm256_permutevar8x32_ps(
+					vec_gradient_z[0], vec_index), _mm256_permutevar8x32_ps(vec_gradient_z[1], vec_index), vec_high), 
+					vec_corner_z[iter_corner]));
+				vec_result = _mm256_add_ps(vec_result, _mm256_mul_ps(_mm256_mul_ps(vec_weight, vec_weight), 
+					vec_gradient));
+			}
+
+			_mm256_storeu_ps(output + iter, _mm256_add_ps(_mm256_loadu_ps(output + iter), 
+				_mm256_mul_ps(_mm256_mul_ps(vec_result, vec_scale), vec_amplitude)));
+		}
+#endif // __AVX2__
+
+		for(; iter < count; ++iter) {
+			output[iter] += (evaluate_noise(x[iter] * frequency, y[iter] * frequency, z[iter] * frequency, 
+				seed) * amplitude);
+		}
+	}
+
+	_craft_simplex_3d *
+	_craft_simplex_3d::acquire(void)
+	{
+
+		if(!craft_simplex_3d::m_instance) {
+
+			craft_simplex_3d::m_instance = new craft_simplex_3d;
+			if(!craft_simplex_3d::m_instance) {
+				THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_ALLOCATED);
+			}
+		}
+
+		return craft_simplex_3d::m_instance;
+	}
+
+	float 
+	_craft_simplex_3d::evaluate_noise(
+		__in float x,
+		__in float y,
+		__in float z,
+		__in uint32_t seed
+		)
+	{
+		uint32_t hash, iter = 0;
+		int32_t cell_x, cell_y, cell_z, offset_x[4] = {0, 0, 0, 1}, offset_y[4] = {0, 0, 0, 1}, 
+			offset_z[4] = {0, 0, 0, 1};
+		float base_x, base_y, base_z, corner_x[4], corner_y[4], corner_z[4], result = 0.f, skew, weight;
+
+		skew = (((x + y) + z) * SIMPLEX_3D_SKEW);
+		base_x = std::floor(x + skew);
+		base_y = std::floor(y + skew);
+		base_z = std::floor(z + skew);
+		skew = (((base_x + base_y) + base_z) * SIMPLEX_3D_UNSKEW);
+		corner_x[0] = (x - (base_x - skew));
+		corner_y[0] = (y - (base_y - skew));
+		corner_z[0] = (z - (base_z - skew));
+		offset_x[1] = ((corner_x[0] >= corner_y[0]) && (corner_x[0] >= corner_z[0]));
+		offset_y[1] = ((corner_y[0] > corner_x[0]) && (corner_y[0] >= corner_z[0]));
+		offset_z[1] = ((corner_z[0] > corner_x[0]) && (corner_z[0] > corner_y[0]));
+		offset_x[2] = ((corner_x[0] >= corner_y[0]) || (corner_x[0] >= corner_z[0]));
+		offset_y[2] = ((corner_y[0] > corner_x[0]) || (corner_y[0] >= corner_z[0]));
+		offset_z[2] = ((corner_z[0] > corner_x[0]) || (corner_z[0] > corner_y[0]));
+
+		for(iter = 1; iter < 4; ++iter) {
+			skew = ((float) iter * SIMPLEX_3D_UNSKEW);
+			corner_x[iter] = ((corner_x[0] - (float) offset_x[iter]) + skew);
+			corner_y[iter] = ((corner_y[0] - (float) offset_y[iter]) + skew);
+			corner_z[iter] = ((corner_z[0] - (float) offset_z[iter]) + skew);
+		}
+
+		cell_x = (int32_t) base_x;
+		cell_y = (int32_t) base_y;
+		cell_z = (int32_t) base_z;
+
+		for(iter = 0; iter < 4; ++iter) {
+			hash = (SIMPLEX_HASH_3D(cell_x + offset_x[iter], cell_y + offset_y[iter], cell_z + offset_z[iter], 
+				seed) >> 28);
+			weight = (((SIMPLEX_3D_RADIUS - (corner_x[iter] * corner_x[iter])) - (corner_y[iter] * corner_y[iter])) 
+				- (corner_z[iter] * corner_z[iter]));
+			weight = ((weight > 0.f) ? weight : 0.f);
+			weight *= weight;
+			result += ((weight * weight) * (((SIMPLEX_3D_GRADIENT_X[hash] * corner_x[iter]) 
+				+ (SIMPLEX_3D_GRADIENT_Y[hash] * corner_y[iter])) + (SIMPLEX_3D_GRADIENT_Z[hash] * corner_z[iter])));
+		}
+
+		return (result * SIMPLEX_3D_SCALE);
+	}
+
+	void 
+	_craft_simplex_3d::generate(
+		__out float *output,
+		__in const float *x,
+		__in const float *y,
+		__in const float *z,
+		__in size_t count,
+		__in_opt uint32_t octaves,
+		__in_opt float frequency,
+		__in_opt float persistence
+		)
+	{
+		size_t iter = 0;
+		uint32_t iter_oct = 0, seed;
+		float amplitude = 1.f, amplitude_total = 0.f;
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(count && (!output || !x || !y || !z)) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_INVALID_PARAMETER);
+		}
+
+		seed = craft_random::acquire()->seed();
+		std::fill(output, output + count, 0.f);
+
+		for(; iter_oct < octaves; ++iter_oct) {
+			accumulate_noise(output, x, y, z, count, craft_random::derive_seed(seed, iter_oct), frequency, 
+				amplitude);
+			amplitude_total += amplitude;
+			amplitude *= persistence;
+			frequency *= SIMPLEX_LACUNARITY;
+		}
+
+		if(amplitude_total > 0.f) {
+
+			for(; iter < count; ++iter) {
+				output[iter] /= amplitude_total;
+			}
+		}
+	}
+
+	void 
+	_craft_simplex_3d::generate(
+		__out std::vector<float> &output,
+		__in const std::vector<glm::vec3> &point,
+		__in_opt uint32_t octaves,
+		__in_opt float frequency,
+		__in_opt float persistence
+		)
+	{
+		size_t begin = 0, count, iter;
+		float block_x[SIMPLEX_BLOCK], block_y[SIMPLEX_BLOCK], block_z[SIMPLEX_BLOCK];
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		output.resize(point.size());
+
+		for(; begin < point.size(); begin += count) {
+			count = std::min(point.size() - begin, (size_t) SIMPLEX_BLOCK);
+
+			for(iter = 0; iter < count; ++iter) {
+				block_x[iter] = point[begin + iter].x;
+				block_y[iter] = point[begin + iter].y;
+				block_z[iter] = point[begin + iter].z;
+			}
+
+			generate(&output[begin], block_x, block_y, block_z, count, octaves, frequency, persistence);
+		}
+	}
+
+	void 
+	_craft_simplex_3d::initialize(void)
+	{
+
+		if(m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_INITIALIZED);
+		}
+
+		m_initialized = true;
+	}
+
+	bool 
+	_craft_simplex_3d::is_allocated(void)
+	{
+		return (craft_simplex_3d::m_instance != NULL);
+	}
+
+	bool 
+	_craft_simplex_3d::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	std::string 
+	_craft_simplex_3d::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << CRAFT_SIMPLEX_3D_HEADER << " (" << (m_initialized ? "INITIALIZED" : "UNINITIALIZED");
+
+		if(verbose) {
+			result << ", PTR. 0x" << SCALAR_AS_HEX(craft_simplex_3d *, this);
+		}
+
+		result << ")";
+
+		return result.str();
+	}
+
+	void 
+	_craft_simplex_3d::uninitialize(void)
+	{
+
+		if(!m_initialized) {
+			THROW_CRAFT_SIMPLEX_EXCEPTION(CRAFT_SIMPLEX_EXCEPTION_UNINITIALIZED);
+		}
+
+		m_initialized = false;
+	}
+}
@@ -20,13 +20,30 @@
 #include "../include/craft.h"
 #include "../include/craft_world_type.h"
 
+#define BLOCK_ATTRIBUTE_VERTEX "vertex"
+#define BLOCK_MVP_UNIFORM "mvp"
+#define BLOCK_SHADER_FRAGMENT "./res/block/fragment.glsl"
+#define BLOCK_SHADER_VERTEX "./res/block/vertex.glsl"
 #define FONT_PATH "./res/test/FreeSans.ttf"
 #define FONT_SIZE 48
 
+enum {
+	WORLD_FIELD_ELEVATION = 0,
+	WORLD_FIELD_TEMPERATURE,
+	WORLD_FIELD_MOISTURE,
+};
+
+#define WORLD_FIELD_COUNT (WORLD_FIELD_MOISTURE + 1)
+
 namespace CRAFT {
 
 	namespace COMPONENT {
 
+		// horizontal offset to the chunk across each face, vertical faces have no neighbour
+		static const glm::vec2 WORLD_NEIGHBOUR_OFFSET[CRAFT_FACE_MAX + 1] = {
+			{-CHUNK_WIDTH, 0}, {CHUNK_WIDTH, 0}, {0, 0}, {0, 0}, {0, -CHUNK_WIDTH}, {0, CHUNK_WIDTH},
+			};
+
 		size_t 
 		_craft_position_key::operator()(
 			__in const glm::vec2 &position
@@ -53,6 +70,11 @@ namespace CRAFT {
 		_craft_world *_craft_world::m_instance = NULL;
 
 		_craft_world::_craft_world(void) :
+			m_block_attribute(0),
+			m_block_matrix(0),
+			m_block_program(0),
+			m_block_shader_fragment(0),
+			m_block_shader_vertex(0),
 			m_font(0),
 			m_initialized(false),
 			m_instance_camera(craft_camera::acquire()),
@@ -112,11 +134,46 @@ namespace CRAFT {
 			m_instance_keyboard->clear();
 			m_instance_mouse->clear();
 			m_instance_text->clear();
-			m_height_list.clear();
+			m_chunk_pending.clear();
 			m_chunk_map.clear();
 			m_window = NULL;
 		}
 
+		const craft_chunk *
+		_craft_world::find_chunk(
+			__in const glm::vec2 &position
+			) const
+		{
+			const craft_chunk *result = NULL;
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::const_iterator iter;
+
+			iter = m_chunk_map.find(position);
+			if(iter != m_chunk_map.end()) {
+				result = &iter->second;
+			}
+
+			return result;
+		}
+
+		void 
+		_craft_world::find_neighbour(
+			__in const glm::vec2 &position,
+			__out std::vector<const craft_chunk *> &neighbour
+			) const
+		{
+			uint32_t iter = 0;
+
+			neighbour.assign(CRAFT_FACE_MAX + 1, NULL);
+
+			for(; iter <= CRAFT_FACE_MAX; ++iter) {
+
+				if((iter != CRAFT_FACE_BOTTOM) && (iter != CRAFT_FACE_TOP)) {
+					neighbour[iter] = find_chunk(position + WORLD_NEIGHBOUR_OFFSET[iter]);
+				}
+			}
+		}
+
 		void 
 		_craft_world::initialize(
 			__in uint32_t seed,
@@ -213,9 +270,50 @@ namespace CRAFT {
 			m_instance_mouse->update();
 		}
 
+		craft_mesh_report 
+		_craft_world::remesh(
+			__in craft_mesh_mode mode
+			)
+		{
+			craft_mesh_stats stats;
+			craft_mesh_report result = {0, 0, 0, 0, 0.0, 0.0, 0};
+			std::vector<const craft_chunk *> neighbour(CRAFT_FACE_MAX + 1, NULL);
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::iterator iter;
+
+			if(!m_initialized) {
+				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
+			}
+
+			// every chunk is rebuilt and uploaded in the new mode, so the totals compare modes on the same terrain
+			for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+				neighbour[CRAFT_FACE_LEFT] = find_chunk(iter->first - glm::vec2(CHUNK_WIDTH, 0));
+				neighbour[CRAFT_FACE_RIGHT] = find_chunk(iter->first + glm::vec2(CHUNK_WIDTH, 0));
+				neighbour[CRAFT_FACE_BACK] = find_chunk(iter->first - glm::vec2(0, CHUNK_WIDTH));
+				neighbour[CRAFT_FACE_FRONT] = find_chunk(iter->first + glm::vec2(0, CHUNK_WIDTH));
+				iter->second.set_mesh_mode(mode);
+				stats = iter->second.rebuild(neighbour);
+				++result.chunks;
+				result.faces += stats.faces;
+				result.vertices += stats.vertices;
+				result.bytes += (stats.vertices * sizeof(craft_uvec4));
+				result.time += stats.time;
+				result.time_max = std::max(result.time_max, stats.time);
+
+				if(stats.time > CHUNK_MESH_BUDGET) {
+					++result.over_budget;
+				}
+			}
+
+			return result;
+		}
+
 		void 
 		_craft_world::render(void)
 		{
+			glm::mat4 mvp;
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::iterator iter;
 
 			if(!m_initialized) {
 				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
@@ -223,11 +321,17 @@ namespace CRAFT {
 
 			glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, 1.f);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			glUseProgram(m_block_program);
+
+			// chunk meshes are in local block coordinates, so each is moved to its key in the world
+			for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+				mvp = (m_mvp * glm::translate(glm::mat4(1.f), 
+					glm::vec3(iter->first.x, 0.f, iter->first.y)));
+				glUniformMatrix4fv(m_block_matrix, 1, GL_FALSE, glm::value_ptr(mvp));
+				iter->second.render(m_block_attribute);
+			}
 
-			// TODO: render world
-			m_instance_test->render(m_mvp);
 			m_instance_text->render(m_mvp);
-			// ---
 
 			glFlush();
 			SDL_GL_SwapWindow(m_window);
@@ -247,6 +351,27 @@ namespace CRAFT {
 			m_instance_mouse->reset();
 		}
 
+		glm::uvec2 
+		_craft_world::section_range(
+			__in const glm::vec2 &position
+			)
+		{
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::iterator iter;
+
+			if(!m_initialized) {
+				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
+			}
+
+			iter = m_chunk_map.find(position);
+			if(iter == m_chunk_map.end()) {
+				THROW_CRAFT_WORLD_EXCEPTION_FORMAT(CRAFT_WORLD_EXCEPTION_CHUNK_NOT_FOUND,
+					"{%f, %f}", position.x, position.y);
+			}
+
+			return iter->second.section_range();
+		}
+
 		void 
 		_craft_world::setup(
 			__in uint32_t seed,
@@ -259,11 +384,14 @@ namespace CRAFT {
 		{
 			glm::vec3 volume;
 			glm::uvec2 result;
+			craft_gl *inst = NULL;
 			int height = 0, width = 0;
 			uint32_t center, count = 1;
-			std::vector<uint8_t> heights;
+			craft_perlin_workspace workspace;
+			std::vector<craft_biome> biomes;
 			glm::vec2 offset, position, position_offset;
-			size_t iter_x, iter_y, iter_height_x, iter_height_y;
+			std::vector<uint8_t> height_list, heights;
+			size_t iter_x, iter_y, iter_height, iter_height_x, iter_height_y;
 
 			if(!m_initialized) {
 				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
@@ -284,7 +412,15 @@ namespace CRAFT {
 			m_instance_text->initialize();
 			reset();
 
+			inst = craft_gl::acquire();
+			m_block_shader_fragment = inst->add_shader(BLOCK_SHADER_FRAGMENT, true, GL_FRAGMENT_SHADER);
+			m_block_shader_vertex = inst->add_shader(BLOCK_SHADER_VERTEX, true, GL_VERTEX_SHADER);
+			m_block_program = inst->add_program(m_block_shader_fragment, m_block_shader_vertex);
+			m_block_matrix = inst->program_uniform(BLOCK_MVP_UNIFORM, m_block_program);
+			m_block_attribute = inst->program_attribute(BLOCK_ATTRIBUTE_VERTEX, m_block_program);
+
 			m_instance_text->add_face(FONT_PATH, FONT_SIZE);
+			m_chunk_pool.initialize(CHUNK_MESH_THREADS);
 
 			// TODO: DEBUG
 			std::stringstream path;
@@ -295,15 +431,20 @@ namespace CRAFT {
 				for(iter_x = PERLIN_POSITION.x; iter_x < (PERLIN_POSITION.x + count); ++iter_x) {
 					position = {iter_x * dimension, iter_y * dimension};
 					offset = {position.x + dimension, position.y + dimension};
-					m_height_list = craft_perlin_2d::acquire()->generate(result, position, 
-						offset, octaves, amplitude, persistence, bicubic);
+
+					// elevation, temperature and moisture come from one pass, interleaved per column
+					height_list.resize(dimension * dimension * WORLD_FIELD_COUNT);
+					craft_perlin_2d::acquire()->generate(height_list.data(), height_list.size(), 
+						{CHUNK_HEIGHT, UINT8_MAX, UINT8_MAX}, workspace, result, position, offset, octaves, 
+						amplitude, persistence, CRAFT_PERLIN_INTERLEAVED, bicubic ? CRAFT_PERLIN_COSINE 
+						: CRAFT_PERLIN_LINEAR, PERLIN_MODE, PERLIN_THREADS);
 
 					// TODO: DEBUG
 					/*path.clear();
 					path.str(std::string());
 					path << "./height_map_" << iter_x << "_" << iter_y;
 					craft_perlin_2d::acquire()->to_file(path.str().c_str(), 
-						m_height_list, result, true);*/
+						height_list, result, true);*/
 					// ---
 				}
 			}
@@ -317,20 +458,26 @@ namespace CRAFT {
 				for(iter_x = 0; iter_x < count; ++iter_x) {
 					position = glm::vec2{iter_x, iter_y};
 					position_offset = glm::vec2{(position.x * CHUNK_WIDTH) - center, (position.y * CHUNK_WIDTH) - center};
+					biomes.clear();
+					biomes.resize(CHUNK_WIDTH * CHUNK_WIDTH);
 					heights.clear();
 					heights.resize(CHUNK_WIDTH * CHUNK_WIDTH, 0);
 
 					for(iter_height_y = 0; iter_height_y < CHUNK_WIDTH; ++iter_height_y) {
 
 						for(iter_height_x = 0; iter_height_x < CHUNK_WIDTH; ++iter_height_x) {
+							iter_height = (((((position.y * CHUNK_WIDTH) + iter_height_y) * dimension) 
+								+ ((position.x * CHUNK_WIDTH) + iter_height_x)) * WORLD_FIELD_COUNT);
 							heights.at(SCALAR_INDEX_2D(iter_height_x, iter_height_y, CHUNK_WIDTH)) 
-								= (uint8_t) (m_height_list.at((((position.y * CHUNK_WIDTH) + iter_height_y) * dimension) 
-									+ ((position.x * CHUNK_WIDTH) + iter_height_x)) * CHUNK_HEIGHT);
+								= height_list.at(iter_height + WORLD_FIELD_ELEVATION);
+							biomes.at(SCALAR_INDEX_2D(iter_height_x, iter_height_y, CHUNK_WIDTH)) 
+								= craft_biome{height_list.at(iter_height + WORLD_FIELD_TEMPERATURE), 
+									height_list.at(iter_height + WORLD_FIELD_MOISTURE)};
 						}
 					}
 
-					m_chunk_map.insert(std::pair<glm::vec2, craft_chunk>(position_offset, 
-						craft_chunk(position, volume, heights)));
+					m_chunk_map.emplace(std::piecewise_construct, std::forward_as_tuple(position_offset), 
+						std::forward_as_tuple(position, volume, heights, biomes));
 
 					// TODO: DEBUG
 					/*if((iter_x == 6) && (iter_y == 7)) {
@@ -347,12 +494,56 @@ namespace CRAFT {
 		void 
 		_craft_world::teardown(void)
 		{
+			craft_gl *inst = NULL;
 
 			if(!m_initialized) {
 				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
 			}
 
+			// workers are stopped before the chunks their snapshots came from are released
+			if(m_chunk_pool.is_initialized()) {
+				m_chunk_pool.uninitialize();
+			}
+
 			clear();
+			glUseProgram(0);
+			m_block_attribute = 0;
+			m_block_matrix = 0;
+			inst = craft_gl::acquire();
+
+			if(m_block_program) {
+
+				if(inst->contains_program(m_block_program)) {
+					inst->decrement_program_reference(m_block_program);
+				} else {
+					glDeleteProgram(m_block_program);
+				}
+
+				m_block_program = 0;
+			}
+
+			if(m_block_shader_fragment) {
+
+				if(inst->contains_shader(m_block_shader_fragment)) {
+					inst->decrement_shader_reference(m_block_shader_fragment);
+				} else {
+					glDeleteShader(m_block_shader_fragment);
+				}
+
+				m_block_shader_fragment = 0;
+			}
+
+			if(m_block_shader_vertex) {
+
+				if(inst->contains_shader(m_block_shader_vertex)) {
+					inst->decrement_shader_reference(m_block_shader_vertex);
+				} else {
+					glDeleteShader(m_block_shader_vertex);
+				}
+
+				m_block_shader_vertex = 0;
+			}
+
 			m_instance_text->uninitialize();
 			m_instance_test->uninitialize();
 			m_instance_camera->uninitialize();
@@ -361,6 +552,51 @@ namespace CRAFT {
 			m_instance_random->uninitialize();
 		}
 
+		craft_tile_stats 
+		_craft_world::to_map(
+			__in const std::string &path,
+			__in_opt uint32_t tile,
+			__in_opt uint32_t threads
+			)
+		{
+			glm::uvec2 dimension;
+			std::vector<uint8_t> color;
+			craft_tile_stats result = {0, 0, 0};
+			glm::vec2 position, position_max, position_min;
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::iterator iter;
+
+			if(!m_initialized) {
+				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
+			}
+
+			if(!m_chunk_map.empty()) {
+				position_min = m_chunk_map.begin()->second.position();
+				position_max = position_min;
+
+				for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+					position = iter->second.position();
+					position_min = {std::min(position_min.x, position.x), std::min(position_min.y, position.y)};
+					position_max = {std::max(position_max.x, position.x), std::max(position_max.y, position.y)};
+				}
+
+				// chunks are laid out by their grid position, one pixel per block column
+				dimension = {(position_max.x - position_min.x + 1) * CHUNK_WIDTH, 
+					(position_max.y - position_min.y + 1) * CHUNK_WIDTH};
+				color.assign((size_t) dimension.x * dimension.y * 3, 0);
+
+				for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+					position = ((iter->second.position() - position_min) * (float) CHUNK_WIDTH);
+					craft_chunk::to_map(&color[SCALAR_INDEX_2D((size_t) position.x, (size_t) position.y, 
+						dimension.x) * 3], dimension.x * 3, iter->second);
+				}
+
+				result = craft_tile_renderer(tile, threads).render(path, color, dimension);
+			}
+
+			return result;
+		}
+
 		std::string 
 		_craft_world::to_string(
 			__in_opt bool verbose
@@ -452,11 +688,78 @@ namespace CRAFT {
 			__in GLfloat delta
 			)
 		{
+			uint32_t border, face;
+			std::vector<const craft_chunk *> neighbour;
+			std::vector<std::unique_ptr<craft_chunk_job>> complete;
+			std::unordered_map<glm::vec2, craft_chunk, craft_position_key, 
+				craft_position_key>::iterator iter, iter_neighbour;
+			std::unordered_map<glm::vec2, std::pair<uint32_t, std::vector<uint32_t>>, craft_position_key, 
+				craft_position_key>::iterator iter_pending;
 
 			if(!m_initialized) {
 				THROW_CRAFT_WORLD_EXCEPTION(CRAFT_WORLD_EXCEPTION_UNINITIALIZED);
 			}
 
+			// finished meshes are only uploaded here, on the thread that owns the gl context
+			m_chunk_pool.collect(complete);
+
+			for(std::vector<std::unique_ptr<craft_chunk_job>>::iterator iter_complete = complete.begin(); 
+					iter_complete != complete.end(); ++iter_complete) {
+
+				if((*iter_complete)->error) {
+					std::rethrow_exception((*iter_complete)->error);
+				}
+
+				iter_pending = m_chunk_pending.find((*iter_complete)->key);
+				if((iter_pending != m_chunk_pending.end()) 
+						&& (iter_pending->second.first == (*iter_complete)->chunk->version())
+						&& (iter_pending->second.second == (*iter_complete)->version)) {
+					m_chunk_pending.erase(iter_pending);
+				}
+
+				// a mesh is only kept if neither the chunk nor any neighbour it was built against has moved on
+				iter = m_chunk_map.find((*iter_complete)->key);
+				if(iter != m_chunk_map.end()) {
+					find_neighbour(iter->first, neighbour);
+					iter->second.upload(*(*iter_complete)->chunk, neighbour, (*iter_complete)->version);
+				}
+			}
+
+			// an edit on a chunk edge changes what the chunk across it can cull, so that chunk is meshed again
+			for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+				border = iter->second.border();
+				if(border) {
+
+					for(face = 0; face <= CRAFT_FACE_MAX; ++face) {
+
+						if(border & (1 << face)) {
+							iter_neighbour = m_chunk_map.find(iter->first + WORLD_NEIGHBOUR_OFFSET[face]);
+							if(iter_neighbour != m_chunk_map.end()) {
+								iter_neighbour->second.set_changed();
+							}
+						}
+					}
+
+					iter->second.clear_border();
+				}
+			}
+
+			// changed chunks are queued once per set of chunk and neighbour versions
+			for(iter = m_chunk_map.begin(); iter != m_chunk_map.end(); ++iter) {
+
+				if(iter->second.has_changed()) {
+					find_neighbour(iter->first, neighbour);
+					iter_pending = m_chunk_pending.find(iter->first);
+					if((iter_pending == m_chunk_pending.end()) 
+							|| (iter_pending->second.first != iter->second.version())
+							|| (iter_pending->second.second != craft_chunk::neighbour_version(neighbour))) {
+						m_chunk_pool.submit(iter->first, iter->second, neighbour);
+						m_chunk_pending[iter->first] = std::make_pair(iter->second.version(), 
+							craft_chunk::neighbour_version(neighbour));
+					}
+				}
+			}
+
 			// TODO: update world logic
 			m_instance_test->update(delta);
 			// ---